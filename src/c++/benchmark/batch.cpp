@@ -0,0 +1,116 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The default number of values stored in the tree, so that
+ * its nodes largely exceed the last-level cache.
+ */
+static const int values = 8000000;
+
+/**
+ * The number of keys looked up by every measure.
+ */
+static const int lookups = 4000000;
+
+/**
+ * The type of the trees, balanced as red-black trees.
+ */
+using tree_type = bst::red_black_tree_t<int>;
+
+/**
+ * @brief Measures the throughput of the given look-up method.
+ * @param name the name of the look-up method.
+ * @param keys the keys to look up.
+ * @param lookup the function looking up the keys, returning
+ * the number of found keys.
+ */
+template <typename Lookup>
+static void benchmark(const std::string& name, const std::vector<int>& keys, Lookup&& lookup) {
+  auto begin = std::chrono::high_resolution_clock::now();
+  auto found = lookup(keys);
+  auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+  std::cout << "  " << name << ": " << (size_t) (keys.size() / elapsed / 1000) << "K lookups/s (" << found << " found)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : values;
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<int> distribution(0, 2 * count - 1);
+  std::vector<int> inserted(count);
+  std::vector<int> keys(lookups);
+
+  // Inserting shuffled values, so that nodes are scattered in memory.
+  std::iota(inserted.begin(), inserted.end(), 0);
+  std::shuffle(inserted.begin(), inserted.end(), engine);
+  for (auto& value : inserted) {
+    value *= 2;
+  }
+  for (auto& key : keys) {
+    key = distribution(engine);
+  }
+
+  auto tree = tree_type();
+  tree.insert(inserted.begin(), inserted.end());
+  inserted = std::vector<int>();
+
+  benchmark("find      ", keys, [&] (const std::vector<int>& keys) {
+    size_t found = 0;
+    for (auto key : keys) {
+      found += tree.find(key).has_value();
+    }
+    return (found);
+  });
+  auto frozen = tree.freeze();
+  benchmark("frozen    ", keys, [&] (const std::vector<int>& keys) {
+    size_t found = 0;
+    for (auto key : keys) {
+      found += frozen.contains(key);
+    }
+    return (found);
+  });
+
+  // Looking up the keys in a frozen copy whose descents do not prefetch.
+  auto unprefetched = bst::frozen_tree_t<int, bst::default_options_t<int>, false>(tree.begin(), tree.end());
+  benchmark("frozen/npf", keys, [&] (const std::vector<int>& keys) {
+    size_t found = 0;
+    for (auto key : keys) {
+      found += unprefetched.contains(key);
+    }
+    return (found);
+  });
+  for (size_t batch = 16; batch <= 1024; batch *= 2) {
+    std::vector<std::optional<const tree_type::node_type*>> results(batch);
+
+    benchmark("batch/" + std::to_string(batch) + std::string(4 - std::to_string(batch).size(), ' '), keys, [&] (const std::vector<int>& keys) {
+      size_t found = 0;
+      for (size_t i = 0; i < keys.size(); i += batch) {
+        auto end = std::min(i + batch, keys.size());
+        auto last = tree.find(keys.begin() + i, keys.begin() + end, results.begin());
+        found += std::count_if(results.begin(), last, [] (const auto& result) {
+          return (result.has_value());
+        });
+      }
+      return (found);
+    });
+  }
+
+  // Looking up the keys once the nodes are laid out in van Emde Boas order.
+  tree.relayout();
+  benchmark("relayout  ", keys, [&] (const std::vector<int>& keys) {
+    size_t found = 0;
+    for (auto key : keys) {
+      found += tree.find(key).has_value();
+    }
+    return (found);
+  });
+  return (0);
+}
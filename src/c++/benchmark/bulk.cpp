@@ -0,0 +1,69 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The default number of values inserted in the tree.
+ */
+static const int values = 10000000;
+
+/**
+ * The type of the trees, balanced as red-black trees.
+ */
+using tree_type = bst::red_black_tree_t<int>;
+
+/**
+ * @brief Measures the time needed to insert the given values
+ * in a tree already holding `existing` values.
+ * @param name the name of the insertion method.
+ * @param existing the values held by the tree before the insertion.
+ * @param inserted the values to insert.
+ * @param insert the function inserting the values in the tree.
+ */
+template <typename Insert>
+static void benchmark(const std::string& name, const std::vector<int>& existing, const std::vector<int>& inserted, Insert&& insert) {
+  auto tree = tree_type();
+  tree.insert(existing.begin(), existing.end());
+
+  auto begin = std::chrono::high_resolution_clock::now();
+  insert(tree, inserted);
+  auto elapsed = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << "  " << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms (" << tree.size() << " values)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : values;
+  auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<int> distribution(0, 2 * count - 1);
+  std::vector<int> existing(count / 4);
+  std::vector<int> inserted(count);
+
+  for (auto& value : existing) {
+    value = distribution(engine);
+  }
+  for (auto& value : inserted) {
+    value = distribution(engine);
+  }
+
+  for (auto tree : {std::vector<int>(), existing}) {
+    std::cout << (tree.empty() ? "empty tree" : "non-empty tree") << std::endl;
+    benchmark("insert       ", tree, inserted, [] (tree_type& tree, const std::vector<int>& values) {
+      tree.insert(values.begin(), values.end());
+    });
+    for (unsigned workers = 1; workers <= threads; workers *= 2) {
+      auto pool = bst::thread_pool_t(workers - 1);
+      benchmark("bulk_insert/" + std::to_string(workers), tree, inserted, [&] (tree_type& tree, const std::vector<int>& values) {
+        tree.bulk_insert(values.begin(), values.end(), pool);
+      });
+    }
+  }
+  return (0);
+}
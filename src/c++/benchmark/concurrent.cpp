@@ -0,0 +1,128 @@
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The default number of operations run by each thread.
+ */
+static const int operations = 1000000;
+
+/**
+ * The number of keys the operations are drawn from.
+ */
+static const int keys = 1000000;
+
+/**
+ * One operation out of `writes` inserts or removes a key,
+ * the other operations looking keys up.
+ */
+static const int writes = 10;
+
+/**
+ * @brief A red-black tree whose calls are serialized by a mutex.
+ */
+struct locked_tree_t {
+  bst::red_black_tree_t<int> tree;
+  std::mutex mutex;
+
+  bool insert(int value) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return (this->tree.insert(value) != nullptr);
+  }
+
+  void remove(int value) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->tree.remove(value);
+  }
+
+  bool contains(int value) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return (std::as_const(this->tree).find(value).has_value());
+  }
+};
+
+/**
+ * @brief A tree sharded in 16 ranges of keys.
+ */
+struct sharded_tree_t : bst::sharded_tree_t<int> {
+  sharded_tree_t(): bst::sharded_tree_t<int>(split_points()) {}
+
+  static std::vector<int> split_points() {
+    std::vector<int> points;
+
+    for (int i = 1; i < 16; ++i) {
+      points.push_back(i * keys / 16);
+    }
+    return (points);
+  }
+};
+
+/**
+ * @brief Measures the time needed by the given number of threads to run
+ * `count` operations each on a tree holding half of the keys.
+ * @param name the name of the tree.
+ * @param threads the number of threads accessing the tree.
+ * @param count the number of operations run by each thread.
+ */
+template <typename Tree>
+static void benchmark(const std::string& name, unsigned threads, int count) {
+  Tree tree;
+  std::vector<std::thread> workers;
+
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<int> distribution(0, keys - 1);
+  for (int i = 0; i < keys / 2; ++i) {
+    tree.insert(distribution(engine));
+  }
+
+  auto begin = std::chrono::high_resolution_clock::now();
+  for (unsigned i = 0; i < threads; ++i) {
+    workers.emplace_back([&tree, count, i] {
+      std::default_random_engine engine(i);
+      std::uniform_int_distribution<int> distribution(0, keys - 1);
+      size_t found = 0;
+
+      for (int n = 0; n < count; ++n) {
+        int value = distribution(engine);
+        if (n % writes) {
+          found += tree.contains(value);
+        } else if (n % (2 * writes)) {
+          tree.remove(value);
+        } else {
+          tree.insert(value);
+        }
+      }
+      // Preventing the lookups from being optimized away.
+      if (found > (size_t) count) {
+        std::cout << found << std::endl;
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  auto elapsed = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << "  " << name << "/" << threads << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : operations;
+  auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (unsigned workers = 1; workers <= threads; workers *= 2) {
+    std::cout << workers << " thread(s)" << std::endl;
+    benchmark<locked_tree_t>("locked red-black tree", workers, count);
+    benchmark<bst::concurrent_tree_t<int>>("concurrent tree      ", workers, count);
+    benchmark<bst::lock_free_tree_t<int>>("lock-free tree       ", workers, count);
+    benchmark<sharded_tree_t>("sharded tree         ", workers, count);
+  }
+  return (0);
+}
@@ -4,6 +4,7 @@
 #include <random>
 #include <chrono>
 #include <array>
+#include <string>
 #include <iostream>
 #include <binary_search_tree.hpp>
 
@@ -12,35 +13,97 @@
  */
 static const size_t iterations = 100000;
 
-int main(void) {
-  std::random_device device;
-  std::default_random_engine engine(device());
-  std::uniform_int_distribution<int> uniform_dist(1, iterations);
-
-  // The array containing random values.
-  auto array = std::array<int, iterations>();
+/**
+ * @brief Computes the number of nodes visited when
+ * looking up the given value in the tree.
+ * @param tree the tree to look up the value in.
+ * @param value the value to look up.
+ * @return the depth at which the value was found.
+ */
+template <typename Tree>
+static size_t search_depth(const Tree& tree, int value) {
+  size_t depth = 0;
 
-  // Fill the array with random values.
-  for (size_t i = 0; i < iterations; ++i) {
-    array[i] = uniform_dist(engine);
+  for (auto node = tree.root(); node; ++depth) {
+    if (value == node->value()) {
+      return (depth + 1);
+    }
+    node = value < node->value() ? node->left : node->right;
   }
+  return (depth);
+}
 
-  // Initializing the clock.
-  auto begin = std::chrono::high_resolution_clock::now();
+/**
+ * @brief Computes the number of nodes visited when looking up
+ * a value in a B+tree, which is the height of the tree.
+ * @param tree the tree to look up the value in.
+ * @return the height of the tree.
+ */
+template <typename T, typename Options, size_t Capacity>
+static size_t search_depth(const bst::btree_t<T, Options, Capacity>& tree, int) {
+  return (tree.stats().height);
+}
 
+/**
+ * @brief Measures the insertion time, the lookup time and the
+ * average search depth of a tree using the given balancing policy.
+ * @param name the name of the balancing policy.
+ * @param array the values to insert and look up.
+ */
+template <typename Tree>
+static void benchmark(const std::string& name, const std::array<int, iterations>& array) {
   // Creating the binary-search tree.
-  auto tree = bst::tree_t<int>();
+  auto tree = Tree();
 
   // Inserting the elements into the tree.
+  auto begin = std::chrono::high_resolution_clock::now();
   for (size_t i = 0; i < iterations; ++i) {
     auto value = array[i];
     tree.insert(value);
     assert(tree.find(value).has_value());
   }
+  auto insertion = std::chrono::high_resolution_clock::now() - begin;
+
+  // Looking up the elements in the tree.
+  size_t found = 0;
+  begin = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    found += tree.find(array[i]).has_value();
+  }
+  auto lookup = std::chrono::high_resolution_clock::now() - begin;
+  assert(found == iterations);
+
+  // Computing the average depth of a lookup.
+  double depth = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    depth += search_depth(tree, array[i]);
+  }
+
+  std::cout << name << std::endl
+    << "  insertion : " << std::chrono::duration_cast<std::chrono::milliseconds>(insertion).count() << "ms" << std::endl
+    << "  lookup    : " << std::chrono::duration_cast<std::chrono::milliseconds>(lookup).count() << "ms (" << found << " found)" << std::endl
+    << "  depth     : " << depth / iterations << " on average" << std::endl;
+}
+
+int main(void) {
+  std::random_device device;
+  std::default_random_engine engine(device());
+  std::uniform_int_distribution<int> uniform_dist(1, iterations);
+
+  // The array containing random values.
+  auto array = std::array<int, iterations>();
+
+  // Fill the array with random values.
+  for (size_t i = 0; i < iterations; ++i) {
+    array[i] = uniform_dist(engine);
+  }
 
-  std::cout << std::chrono::duration_cast<std::chrono::milliseconds>(
-    std::chrono::high_resolution_clock::now() - begin
-  ).count() << "ms" << std::endl;
+  benchmark<bst::tree_t<int>>("unbalanced", array);
+  benchmark<bst::red_black_tree_t<int>>("red-black", array);
+  benchmark<bst::avl_tree_t<int>>("avl", array);
+  benchmark<bst::scapegoat_tree_t<int>>("scapegoat", array);
+  benchmark<bst::tree_t<int, bst::red_black_t, bst::default_options_t<int>, bst::pool_allocator_t<int>>>("red-black (pool allocator)", array);
+  benchmark<bst::btree_t<int>>("b+tree", array);
 
   return (0);
-}
\ No newline at end of file
+}
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The default number of keys stored in each tree.
+ */
+static const int keys = 10000000;
+
+/**
+ * The type of the trees, balanced as red-black trees.
+ */
+using tree_type = bst::red_black_tree_t<int>;
+
+/**
+ * @return `count` sorted random keys drawn in `[0, 2 * count)`,
+ * so that about half of the keys of two sets overlap.
+ */
+static std::vector<int> random_keys(int count, unsigned seed) {
+  std::default_random_engine engine(seed);
+  std::uniform_int_distribution<int> distribution(0, 2 * count - 1);
+  std::vector<int> values(count);
+
+  for (auto& value : values) {
+    value = distribution(engine);
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return (values);
+}
+
+/**
+ * @brief Measures the time needed to run the given set operation
+ * on trees built from the given keys.
+ * @param name the name of the operation.
+ * @param lhs the keys of the tree the operation is applied to.
+ * @param rhs the keys of the other tree.
+ * @param operation the function applying the operation.
+ */
+template <typename Operation>
+static void benchmark(const std::string& name, const std::vector<int>& lhs, const std::vector<int>& rhs, Operation&& operation) {
+  auto tree  = tree_type();
+  auto other = tree_type();
+  tree.build_from_sorted(lhs.begin(), lhs.end());
+  other.build_from_sorted(rhs.begin(), rhs.end());
+
+  auto begin = std::chrono::high_resolution_clock::now();
+  operation(tree, other);
+  auto elapsed = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << "  " << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms (" << tree.size() << " keys)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : keys;
+  auto lhs = random_keys(count, 1);
+  auto rhs = random_keys(count, 2);
+  auto sequential = bst::thread_pool_t(0);
+  auto& parallel = bst::default_thread_pool();
+
+  std::cout << "union" << std::endl;
+  benchmark("element-wise", lhs, rhs, [] (tree_type& tree, tree_type& other) {
+    for (auto value : other) {
+      tree.insert(value);
+    }
+  });
+  benchmark("sequential  ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.union_with(std::move(other), sequential);
+  });
+  benchmark("parallel    ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.union_with(std::move(other), parallel);
+  });
+
+  std::cout << "intersection" << std::endl;
+  benchmark("element-wise", lhs, rhs, [] (tree_type& tree, tree_type& other) {
+    for (auto it = tree.begin(); it != tree.end();) {
+      auto value = *it++;
+      if (!other.find(value).has_value()) {
+        tree.remove(value);
+      }
+    }
+  });
+  benchmark("sequential  ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.intersect_with(other, sequential);
+  });
+  benchmark("parallel    ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.intersect_with(other, parallel);
+  });
+
+  std::cout << "difference" << std::endl;
+  benchmark("element-wise", lhs, rhs, [] (tree_type& tree, tree_type& other) {
+    for (auto value : other) {
+      tree.remove(value);
+    }
+  });
+  benchmark("sequential  ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.difference_with(other, sequential);
+  });
+  benchmark("parallel    ", lhs, rhs, [&] (tree_type& tree, tree_type& other) {
+    tree.difference_with(other, parallel);
+  });
+  return (0);
+}
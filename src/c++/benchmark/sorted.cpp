@@ -0,0 +1,70 @@
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The number of sorted elements to insert into the balanced trees.
+ */
+static const int iterations = 1000000;
+
+/**
+ * @brief Measures the time needed to insert, look up and clear
+ * sorted keys, which degrades unbalanced trees into a list, and
+ * compares it with building the tree at once from the sorted keys.
+ * @param name the name of the balancing policy.
+ * @param count the number of keys to insert.
+ */
+template <typename Tree>
+static void benchmark(const std::string& name, int count) {
+  // Creating the binary-search tree.
+  auto tree = Tree();
+
+  // Inserting the sorted elements into the tree.
+  auto begin = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < count; ++i) {
+    tree.insert(i);
+  }
+  auto insertion = std::chrono::high_resolution_clock::now() - begin;
+
+  // Looking up the largest element, which is the deepest one
+  // in an unbalanced tree.
+  begin = std::chrono::high_resolution_clock::now();
+  if (!tree.find(count - 1).has_value()) {
+    std::abort();
+  }
+  auto lookup = std::chrono::high_resolution_clock::now() - begin;
+
+  // Clearing the tree.
+  begin = std::chrono::high_resolution_clock::now();
+  tree.clear();
+  auto teardown = std::chrono::high_resolution_clock::now() - begin;
+
+  // Building the tree at once from the same sorted keys.
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  begin = std::chrono::high_resolution_clock::now();
+  tree.build_from_sorted(keys.begin(), keys.end());
+  auto build = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << name << " (" << count << " keys)" << std::endl
+    << "  insertion : " << std::chrono::duration_cast<std::chrono::milliseconds>(insertion).count() << "ms" << std::endl
+    << "  lookup    : " << std::chrono::duration_cast<std::chrono::microseconds>(lookup).count() << "us" << std::endl
+    << "  teardown  : " << std::chrono::duration_cast<std::chrono::milliseconds>(teardown).count() << "ms" << std::endl
+    << "  bulk build: " << std::chrono::duration_cast<std::chrono::milliseconds>(build).count() << "ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  // Unbalanced insertion of sorted keys is quadratic, the number
+  // of keys can be raised up to `iterations` from the command-line.
+  int unbalanced = argc > 1 ? std::atoi(argv[1]) : iterations / 20;
+
+  benchmark<bst::red_black_tree_t<int>>("red-black", iterations);
+  benchmark<bst::avl_tree_t<int>>("avl", iterations);
+  benchmark<bst::scapegoat_tree_t<int>>("scapegoat", iterations);
+  benchmark<bst::tree_t<int>>("unbalanced", unbalanced);
+  return (0);
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <binary_search_tree.hpp>
+
+/**
+ * The default number of values stored in the trees.
+ */
+static const int values = 4000000;
+
+/**
+ * The number of keys looked up by every measure.
+ */
+static const int lookups = 4000000;
+
+/**
+ * @brief Measures the throughput of the given look-up function.
+ * @param name the name of the look-up method.
+ * @param keys the keys to look up.
+ * @param contains the function returning whether a key is found.
+ */
+template <typename T, typename Contains>
+static void benchmark(const std::string& name, const std::vector<T>& keys, Contains&& contains) {
+  size_t found = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+
+  for (auto key : keys) {
+    found += contains(key);
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+  std::cout << "  " << name << ": " << (size_t) (keys.size() / elapsed / 1000) << "K lookups/s (" << found << " found)" << std::endl;
+}
+
+/**
+ * @brief Compares the look-ups of a red-black tree holding `count` values
+ * of type `T`, of its frozen copy, and of the static B-tree built from it.
+ */
+template <typename T>
+static void benchmark(const std::string& name, int count) {
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<T> distribution(0, 2 * (T) count - 1);
+  std::vector<T> inserted(count);
+  std::vector<T> keys(lookups);
+
+  std::iota(inserted.begin(), inserted.end(), 0);
+  std::shuffle(inserted.begin(), inserted.end(), engine);
+  for (auto& value : inserted) {
+    value *= 2;
+  }
+  for (auto& key : keys) {
+    key = distribution(engine);
+  }
+
+  auto tree = bst::red_black_tree_t<T>();
+  tree.insert(inserted.begin(), inserted.end());
+  auto frozen = tree.freeze();
+  auto index = bst::static_btree_t<T>(tree.begin(), tree.end());
+
+  std::cout << name << " (" << index.instruction_set() << ")" << std::endl;
+  benchmark("find        ", keys, [&] (T key) {
+    return (std::as_const(tree).find(key).has_value());
+  });
+  benchmark("frozen      ", keys, [&] (T key) {
+    return (frozen.contains(key));
+  });
+  benchmark("static_btree", keys, [&] (T key) {
+    return (index.contains(key));
+  });
+}
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : values;
+
+  benchmark<int32_t>("int32_t", count);
+  benchmark<int64_t>("int64_t", count);
+  return (0);
+}
@@ -0,0 +1,43 @@
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <binary_search_tree.hpp>
+
+/**
+ * The number of elements to insert into the tree.
+ */
+static const int iterations = 10000000;
+
+/**
+ * @brief Measures the time needed to build and to tear down
+ * a tree using the given allocator.
+ * @param name the name of the allocator.
+ */
+template <typename Allocator>
+static void benchmark(const std::string& name) {
+  // Creating the binary-search tree.
+  auto tree = bst::tree_t<int, bst::red_black_t, bst::default_options_t<int>, Allocator>();
+
+  // Inserting the elements into the tree.
+  auto begin = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert(i);
+  }
+  auto insertion = std::chrono::high_resolution_clock::now() - begin;
+
+  // Tearing down the tree.
+  begin = std::chrono::high_resolution_clock::now();
+  tree.clear();
+  auto teardown = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << name << std::endl
+    << "  insertion : " << std::chrono::duration_cast<std::chrono::milliseconds>(insertion).count() << "ms" << std::endl
+    << "  teardown  : " << std::chrono::duration_cast<std::chrono::milliseconds>(teardown).count() << "ms" << std::endl;
+}
+
+int main(void) {
+  benchmark<std::allocator<int>>("std::allocator");
+  benchmark<bst::pool_allocator_t<int>>("pool allocator");
+  benchmark<bst::arena_allocator_t<int>>("arena allocator");
+  return (0);
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+#include <binary_search_tree.hpp>
+
+/**
+ * The number of distinct keys stored in the trees.
+ */
+static const int keys = 1000000;
+
+/**
+ * The number of lookups performed on the trees.
+ */
+static const int lookups = 5000000;
+
+/**
+ * The exponent of the Zipf distribution, with which about
+ * 1% of the keys receive most of the lookups.
+ */
+static const double exponent = 1.2;
+
+/**
+ * @brief Measures the time needed to look up keys following
+ * a Zipf distribution in a tree holding random keys.
+ * @param name the name of the balancing policy.
+ * @param values the keys to insert, in insertion order.
+ * @param workload the keys to look up.
+ */
+template <typename Tree>
+static void benchmark(const std::string& name, const std::vector<int>& values, const std::vector<int>& workload) {
+  // Creating the binary-search tree.
+  auto tree = Tree();
+  tree.insert(values.begin(), values.end());
+
+  // Looking up the keys, which restructures splay trees.
+  size_t found = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for (auto key : workload) {
+    found += tree.find(key).has_value();
+  }
+  auto lookup = std::chrono::high_resolution_clock::now() - begin;
+
+  std::cout << name << std::endl
+    << "  lookup    : " << std::chrono::duration_cast<std::chrono::milliseconds>(lookup).count() << "ms (" << found << " found)" << std::endl
+    << "  height    : " << tree.stats().height << std::endl;
+}
+
+int main(void) {
+  std::default_random_engine engine(42);
+
+  // Inserting the keys in a random order.
+  std::vector<int> values(keys);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), engine);
+
+  // The key of rank `k` is looked up with a probability
+  // proportional to 1 / k^exponent. Ranks are assigned to
+  // random keys so that hot keys are spread across the tree.
+  std::vector<double> weights(keys);
+  for (int k = 0; k < keys; ++k) {
+    weights[k] = 1.0 / std::pow(k + 1, exponent);
+  }
+  std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+  std::vector<int> workload(lookups);
+  for (auto& key : workload) {
+    key = values[zipf(engine)];
+  }
+
+  benchmark<bst::tree_t<int>>("unbalanced", values, workload);
+  benchmark<bst::red_black_tree_t<int>>("red-black", values, workload);
+  benchmark<bst::avl_tree_t<int>>("avl", values, workload);
+  benchmark<bst::splay_tree_t<int>>("splay", values, workload);
+  return (0);
+}
@@ -55,11 +55,40 @@ static auto complex_options = bst::options_t<complex_t>(
   }
 );
 
+/**
+ * @brief A comparator ordering strings by their length,
+ * resolved at compile-time.
+ */
+struct length_comparator_t {
+  bool operator()(const std::string& a, const std::string& b) const {
+    return (a.size() < b.size());
+  }
+};
+
+/**
+ * @brief A stringifier returning strings as-is.
+ */
+struct identity_stringifier_t {
+  std::string operator()(const std::string& value) const {
+    return (value);
+  }
+};
+
+/**
+ * @brief Options for a binary search tree containing strings
+ * ordered by their length, resolved at compile-time.
+ */
+using length_options_t = bst::options_t<
+  std::string,
+  length_comparator_t,
+  identity_stringifier_t
+>;
+
 /**
  * @brief Displays information about the given tree.
  */
-template <typename T>
-std::string format(const bst::tree_t<T>& tree) {
+template <typename Tree>
+std::string format(const Tree& tree) {
   std::stringstream ss;
 
   ss << "Size : " << tree.size() << std::endl
@@ -71,15 +100,17 @@ std::string format(const bst::tree_t<T>& tree) {
 
 int main(void) {
   // Creating different trees with different types.
-  auto complex_tree = bst::tree_t<complex_t>(complex_options);
-  auto string_tree  = bst::tree_t<std::string>(string_options);
+  auto complex_tree = bst::tree_t(complex_options);
+  auto string_tree  = bst::tree_t(string_options);
   auto double_tree  = bst::tree_t<double>();
   auto float_tree   = bst::tree_t<float>();
+  auto length_tree  = bst::tree_t<std::string, bst::unbalanced_t, length_options_t>();
 
   // Insert the data into the tree.
   string_tree.insert("abc", "aaa", "bbb", "ab");
   double_tree.insert(2.0, 4.0, 5.0, 3.0, 6.0);
   float_tree.insert(2.0f, 4.0f, 5.0f, 3.0f, 6.0f);
+  length_tree.insert("abc", "a", "abcde", "ab");
   complex_tree.insert(
     complex_t(50),
     complex_t(70),
@@ -92,6 +123,7 @@ int main(void) {
   std::cout << format(double_tree) << std::endl;
   std::cout << format(float_tree) << std::endl;
   std::cout << format(complex_tree) << std::endl;
+  std::cout << format(length_tree) << std::endl;
 
   return (0);
 }
\ No newline at end of file
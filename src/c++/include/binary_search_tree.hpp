@@ -3,10 +3,31 @@
 
 #include <string>
 #include <vector>
+#include <array>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <iterator>
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+#include <stdexcept>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 
 namespace bst {
   
@@ -19,31 +40,78 @@ namespace bst {
     RIGHT
   };  
 
+  /**
+   * @brief The default comparator, ordering values using
+   * their `<` operator.
+   */
+  template <typename T>
+  struct default_comparator_t {
+
+    /**
+     * @brief Compares two values.
+     * @param lhs the first value to compare.
+     * @param rhs the second value to compare.
+     * @return 0 if the values are equal, a negative value if `lhs`
+     * is less than `rhs`, and a positive value otherwise.
+     */
+    int operator()(const T& lhs, const T& rhs) const {
+      return ((rhs < lhs) - (lhs < rhs));
+    }
+  };
+
+  /**
+   * @brief The default stringifier, transforming values
+   * into strings using `std::to_string`.
+   */
+  template <typename T>
+  struct default_stringifier_t {
+
+    /**
+     * @brief Transforms a value into a string.
+     * @param value the value to transform.
+     * @return the resulting string.
+     */
+    std::string operator()(const T& value) const {
+      return (std::to_string(value));
+    }
+  };
+
   /**
    * @brief Describes the options that can be passed to the
    * binary-search tree.
+   * @tparam T the type of the values stored in the tree.
+   * @tparam Comparator the type of the comparator, either returning
+   * an integer as a three-way comparison, or a boolean as `std::less`.
+   * @tparam Stringifier the type of the stringifier.
+   * @note The default `options_t<T>` type-erases its functions, while trees use
+   * `default_options_t<T>` unless configured otherwise, which lets the compiler
+   * inline comparisons.
    */
-  template <typename T>
+  template <
+    typename T,
+    typename Comparator = std::function<int(const T&, const T&)>,
+    typename Stringifier = std::function<std::string(const T&)>
+  >
   struct options_t {
 
     /**
      * @brief Type definition for the comparator function
      * implementation used to compare values together.
      */
-    using comparator_t = std::function<int(const T&, const T&)>;
+    using comparator_t = Comparator;
 
     /**
      * @brief Type definition for the to_string function
      * implementation used to transform values into strings.
      */
-    using to_string_t = std::function<std::string(const T&)>;
+    using to_string_t = Stringifier;
 
     /**
      * @brief The binary search tree options.
      * @param c the comparator function.
      * @param s the stringifier function.
      */
-    options_t(comparator_t c, to_string_t s)
+    options_t(comparator_t c = comparator_t(), to_string_t s = to_string_t())
       : comparator(c), stringifier(s) {}
     
     /**
@@ -51,9 +119,16 @@ namespace bst {
      * @param lhs the first value to compare.
      * @param rhs the second value to compare.
      * @return the result of the comparison.
+     * @note Keys of another type than `T` can be compared
+     * with values when the comparator accepts them.
      */
-    int compare(const T& lhs, const T& rhs) const {
-      return (comparator(lhs, rhs));
+    template <typename Lhs, typename Rhs>
+    int compare(const Lhs& lhs, const Rhs& rhs) const {
+      if constexpr (std::is_same_v<std::invoke_result_t<const comparator_t&, const Lhs&, const Rhs&>, bool>) {
+        return (comparator(lhs, rhs) ? -1 : comparator(rhs, lhs));
+      } else {
+        return (comparator(lhs, rhs));
+      }
     }
 
     /**
@@ -71,660 +146,7068 @@ namespace bst {
   };
 
   /**
-   * Forward declaration of the depth-first-search iterator.
+   * @brief The options used by default by the binary-search tree,
+   * resolving the comparator and the stringifier at compile-time.
    */
   template <typename T>
+  using default_options_t = options_t<T, default_comparator_t<T>, default_stringifier_t<T>>;
+
+  /**
+   * @brief Describes the metadata associated with the nodes
+   * of a tree that does not need to store any balancing information.
+   */
+  struct no_metadata_t {};
+
+  /**
+   * Forward declaration of the depth-first-search iterator.
+   */
+  template <typename Tree>
   class dfs_iterator_t;
 
   /**
    * Forward declaration of the node.
    */
-  template <typename T>
+  template <typename T, typename Metadata = no_metadata_t>
   struct node_t;
 
   /**
-   * @brief Definition of the binary search tree.
+   * Forward declaration of the frozen tree.
    */
-  template <typename T, typename DefaultIterator = dfs_iterator_t<T>>
-  struct tree_t {
+  template <typename T, typename Options = default_options_t<T>, bool Prefetch = true>
+  class frozen_tree_t;
+
+  /**
+   * @brief The default balancing policy, which never restructures
+   * the tree. Nodes are attached and removed as-is, which keeps
+   * the tree layout predictable at the cost of a worst-case
+   * height of O(n).
+   */
+  struct unbalanced_t {
 
     /**
-     * The default iterator has access to the binary-search tree
-     * implementation.
+     * @brief Unbalanced trees do not store any metadata in their nodes.
      */
-    friend DefaultIterator;
+    using metadata_t = no_metadata_t;
 
     /**
-     * Defining the default iterator at the tree level.
+     * @brief Called after a new node has been attached to the tree.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
      */
-    using const_iterator = DefaultIterator;
-    using iterator = const_iterator;
+    template <typename Tree, typename Node>
+    void on_insert(Tree&, Node*) {}
 
     /**
-     * @brief Ensures that the given variadic arguments are
-     * convertible to the given type.
+     * @brief Called after a node has been unlinked from the tree.
+     * @param tree the tree the node has been removed from.
+     * @param removed the node that has been unlinked.
+     * @param child the node that took the place of the unlinked position.
+     * @param parent the parent of `child`.
      */
-    template<typename Type, typename... Ts>
-    using all_of_type = std::enable_if_t<std::conjunction_v<std::is_same<Type, Ts>...>>;
+    template <typename Tree, typename Node>
+    void on_remove(Tree&, Node*, Node*, Node*) {}
 
     /**
-     * @brief Construct a new binary search tree object.
-     * @param options the options to associate to the tree.
+     * @brief Called bottom-up on every node of a tree built balanced,
+     * whose leaves all lie at `max_depth` or `max_depth - 1`.
+     * @param tree the tree being built.
+     * @param node the node whose children have been built.
+     * @param depth the depth of the node.
+     * @param max_depth the depth of the deepest leaves of the tree.
      */
-    tree_t(): root_{nullptr}, size_of_tree{0}, options(
-      [] (const T& a, const T& b) -> int {
-        return (a - b);
-      },
-      [] (const T& value) -> std::string {
-        return (std::to_string(value));
-      }) {}
+    template <typename Tree, typename Node>
+    void on_build(Tree&, Node*, size_t, size_t) {}
 
     /**
-     * @brief Construct a new binary search tree object.
-     * @param options the options to associate to the tree.
+     * @brief Called when a node is looked up in a non-const tree.
+     * @param tree the tree the node belongs to.
+     * @param node the node that has been accessed.
      */
-    tree_t(const options_t<T>& options): root_{nullptr}, size_of_tree{0}, options{options} {}
-    
+    template <typename Tree, typename Node>
+    void on_access(Tree&, Node*) {}
+
     /**
-     * Copy-constructor is deleted.
+     * @brief Called to join two detached subtrees under a detached node,
+     * making the result the root of the tree. The values of `left` are
+     * less than the value of `middle`, which is less than the values of `right`.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
+     * @note Unbalanced trees make `middle` the root, which is O(1).
      */
-    tree_t(const tree_t&) = delete;
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      tree.graft(left, middle, right, RIGHT, [] (const Node*) { return (true); });
+    }
+  };
+
+  /**
+   * @brief Describes the color of a node in a red-black tree.
+   */
+  enum color_t : unsigned char {
+    RED,
+    BLACK
+  };
+
+  /**
+   * @brief A balancing policy implementing a red-black tree.
+   * Guarantees a height of at most 2log(n + 1) by recoloring
+   * and rotating nodes on insertion and removal.
+   */
+  struct red_black_t {
 
     /**
-     * Assignment operator is deleted. 
+     * @brief Red-black nodes store their color, and the number of
+     * black nodes on a path from them to a leaf, so that subtrees
+     * are joined without walking down their spines.
      */
-    tree_t& operator=(const tree_t&) = delete;
+    struct metadata_t {
+      color_t color = RED;
+      unsigned char black_height = 0;
+    };
 
     /**
-     * @brief Binary-search tree destructor.
+     * @brief Restores the red-black properties after a new
+     * red node has been attached to the tree.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
+     * @note Complexity is O(log(n)), with at most two rotations.
      */
-    ~tree_t() {
-      this->clear();
+    template <typename Tree, typename Node>
+    void on_insert(Tree& tree, Node* node) {
+      node->color = RED;
+      update(node);
+
+      while (node->parent && node->parent->color == RED) {
+        // The parent is red, so it cannot be the root and
+        // the grandparent is guaranteed to exist.
+        auto parent      = node->parent;
+        auto grandparent = parent->parent;
+
+        if (parent == grandparent->left) {
+          auto uncle = grandparent->right;
+
+          if (uncle && uncle->color == RED) {
+            // Pushing the blackness of the grandparent down.
+            parent->color      = BLACK;
+            uncle->color       = BLACK;
+            grandparent->color = RED;
+            update(parent);
+            update(uncle);
+            update(grandparent);
+            node = grandparent;
+          } else {
+            // Turning an inner grandchild into an outer one.
+            if (node == parent->right) {
+              node = parent;
+              tree.rotate_left(node);
+              parent = node->parent;
+            }
+            parent->color      = BLACK;
+            grandparent->color = RED;
+            tree.rotate_right(grandparent);
+            update(grandparent);
+            update(parent);
+          }
+        } else {
+          auto uncle = grandparent->left;
+
+          if (uncle && uncle->color == RED) {
+            // Pushing the blackness of the grandparent down.
+            parent->color      = BLACK;
+            uncle->color       = BLACK;
+            grandparent->color = RED;
+            update(parent);
+            update(uncle);
+            update(grandparent);
+            node = grandparent;
+          } else {
+            // Turning an inner grandchild into an outer one.
+            if (node == parent->left) {
+              node = parent;
+              tree.rotate_right(node);
+              parent = node->parent;
+            }
+            parent->color      = BLACK;
+            grandparent->color = RED;
+            tree.rotate_left(grandparent);
+            update(grandparent);
+            update(parent);
+          }
+        }
+      }
+      tree.root_->color = BLACK;
+      update(tree.root_);
     }
 
     /**
-     * @brief Inserts a set of values provided by the iterator
-     * in the binary-search tree.
-     * @param begin the iterator to the beginning of the iterable.
-     * @param end the iterator to the end of the iterable.
+     * @brief Restores the red-black properties after a node
+     * has been unlinked from the tree.
+     * @param tree the tree the node has been removed from.
+     * @param removed the node that has been unlinked, holding the
+     * color of the position that disappeared from the tree.
+     * @param node the node that took the place of the unlinked position.
+     * @param parent the parent of `node`.
+     * @note Complexity is O(log(n)), with at most three rotations.
      */
-    template<typename Iterator>
-    void insert(Iterator begin, Iterator end) {
-      for (Iterator it = begin; it != end; ++it) {
-        this->insert(*it);
+    template <typename Tree, typename Node>
+    void on_remove(Tree& tree, Node* removed, Node* node, Node* parent) {
+      // Removing a red node never breaks the black-height.
+      if (removed->color == RED) {
+        return;
+      }
+
+      // The black-heights of the ancestors of the unlinked position
+      // are recomputed once the red-black properties are restored.
+      auto ancestor = parent ? parent : node;
+      while (node != tree.root_ && is_black(node)) {
+        // The sibling cannot be null, since the subtree of `node`
+        // lacks one black node compared to the sibling subtree.
+        if (node == parent->left) {
+          auto sibling = parent->right;
+
+          if (sibling->color == RED) {
+            sibling->color = BLACK;
+            parent->color  = RED;
+            tree.rotate_left(parent);
+            sibling = parent->right;
+          }
+          if (is_black(sibling->left) && is_black(sibling->right)) {
+            // Moving the missing black node up the tree.
+            sibling->color = RED;
+            update(sibling);
+            node   = parent;
+            parent = node->parent;
+          } else {
+            if (is_black(sibling->right)) {
+              sibling->left->color = BLACK;
+              sibling->color = RED;
+              tree.rotate_right(sibling);
+              update(sibling);
+              sibling = parent->right;
+            }
+            sibling->color        = parent->color;
+            parent->color         = BLACK;
+            sibling->right->color = BLACK;
+            tree.rotate_left(parent);
+            update(sibling->right);
+            node = tree.root_;
+          }
+        } else {
+          auto sibling = parent->left;
+
+          if (sibling->color == RED) {
+            sibling->color = BLACK;
+            parent->color  = RED;
+            tree.rotate_right(parent);
+            sibling = parent->left;
+          }
+          if (is_black(sibling->left) && is_black(sibling->right)) {
+            // Moving the missing black node up the tree.
+            sibling->color = RED;
+            update(sibling);
+            node   = parent;
+            parent = node->parent;
+          } else {
+            if (is_black(sibling->left)) {
+              sibling->right->color = BLACK;
+              sibling->color = RED;
+              tree.rotate_left(sibling);
+              update(sibling);
+              sibling = parent->left;
+            }
+            sibling->color       = parent->color;
+            parent->color        = BLACK;
+            sibling->left->color = BLACK;
+            tree.rotate_right(parent);
+            update(sibling->left);
+            node = tree.root_;
+          }
+        }
+      }
+
+      if (node) {
+        node->color = BLACK;
+        update(node);
+      }
+      for (; ancestor; ancestor = ancestor->parent) {
+        update(ancestor);
       }
     }
 
     /**
-     * @brief Inserts a set of values provided as variadic arguments
-     * in the binary search tree.
-     * @param args the values to insert in the tree.
+     * @brief Colors the nodes of a tree built balanced, the deepest
+     * leaves being red and every other node black, which gives every
+     * path the same number of black nodes.
+     * @param tree the tree being built.
+     * @param node the node whose children have been built.
+     * @param depth the depth of the node.
+     * @param max_depth the depth of the deepest leaves of the tree.
+     * @note Complexity is O(1).
      */
-    template <class... Args>
-    void insert(Args... args) {
-      auto callable = [&] (const T& arg) { this->insert(arg); };
-      (callable(std::forward<Args>(args)),...);
+    template <typename Tree, typename Node>
+    void on_build(Tree&, Node* node, size_t depth, size_t max_depth) {
+      node->color = depth > 0 && depth == max_depth ? RED : BLACK;
+      update(node);
     }
 
     /**
-     * @brief Inserts the given `data` in the binary-search tree.
-     * @param data a reference to the data to insert in the binary-search tree.
-     * @return a pointer to the created node that wraps the given data.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Lookups do not restructure red-black trees.
      */
-    const node_t<T>* insert(const T& data) {
-      // The tree is empty.
-      if (!this->size_of_tree) {
-        auto new_node      = new node_t<T>(data);
-        new_node->tree     = this;
-        this->size_of_tree = 1;
-        return (this->root_ = new_node);
+    template <typename Tree, typename Node>
+    void on_access(Tree&, Node*) {}
+
+    /**
+     * @brief Joins two detached subtrees under a detached node, by
+     * linking the node along the spine of the subtree of greater
+     * black-height, next to a black node of the same black-height
+     * as the other subtree, and restoring the red-black properties
+     * as if the node had been inserted.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
+     * @note Complexity is O(|h(left) - h(right)| + 1), the stored
+     * black-heights sparing a walk down the spines.
+     */
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      // Subtrees split off a red-black tree may have a red root.
+      if (left) {
+        left->color = BLACK;
+        update(left);
+      }
+      if (right) {
+        right->color = BLACK;
+        update(right);
       }
 
-      // Otherwise, we recursively traverse the tree to find
-      // the right position for the new node.
-      return (insert(this->root_, data));
+      auto left_height  = black_height(left);
+      auto right_height = black_height(right);
+
+      if (left_height >= right_height) {
+        auto height = left_height;
+        tree.graft(left, middle, right, RIGHT, [&] (const Node* node) {
+          return (node->color == BLACK && height-- == right_height);
+        });
+      } else {
+        auto height = right_height;
+        tree.graft(right, middle, left, LEFT, [&] (const Node* node) {
+          return (node->color == BLACK && height-- == left_height);
+        });
+      }
+      this->on_insert(tree, middle);
     }
 
+    private:
+
+      /**
+       * @return the number of black nodes on a path from the
+       * given node to a leaf, including the node itself.
+       */
+      template <typename Node>
+      static size_t black_height(const Node* node) {
+        return (node ? node->black_height : 0);
+      }
+
+      /**
+       * @brief Recomputes the black-height of the given node
+       * from its color and the black-height of its children.
+       */
+      template <typename Node>
+      static void update(Node* node) {
+        node->black_height = black_height(node->left) + (node->color == BLACK);
+      }
+
+      /**
+       * @return whether the given node is black, null nodes
+       * being considered as black leaves.
+       */
+      template <typename Node>
+      static bool is_black(const Node* node) {
+        return (!node || node->color == BLACK);
+      }
+  };
+
+  /**
+   * @brief A balancing policy implementing an AVL tree.
+   * Keeps the heights of the two subtrees of every node within
+   * one of each other, which bounds the height to 1.44log(n + 2).
+   * This makes lookups cheaper than in a red-black tree at the
+   * cost of more rotations on insertion and removal.
+   */
+  struct avl_t {
+
     /**
-     * @brief Removes a set of values provided by the iterator
-     * from the binary-search tree.
-     * @param begin the iterator to the beginning of the iterable.
-     * @param end the iterator to the end of the iterable.
+     * @brief AVL nodes store the height of their subtree.
      */
-    template<typename Iterator>
-    void remove(Iterator begin, Iterator end) {
-      for (Iterator it = begin; it != end; ++it) {
-        this->remove(*it);
-      }
-    }
+    struct metadata_t {
+      int height = 1;
+    };
 
     /**
-     * @brief Removes a set of values provided as variadic arguments
-     * from the binary search tree.
-     * @param args the values to remove from the tree.
-     * @note Complexity is O(nlog(n)) on average, O(n2) on the worst case.
+     * @brief Rebalances the ancestors of a newly attached node.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
+     * @note Complexity is O(log(n)).
      */
-    template <class... Args>
-    void remove(Args... args) {
-      auto callable = [&] (const T& arg) { this->remove(arg); };
-      (callable(std::forward<Args>(args)),...);
+    template <typename Tree, typename Node>
+    void on_insert(Tree& tree, Node* node) {
+      node->height = 1;
+      this->retrace(tree, node->parent);
     }
 
     /**
-     * @brief Removes the node associated with the given `data` from the binary-search tree
-     * starting from the given subtree.
-     * @param node the subtree to walk the tree from. 
-     * @param data the data to remove from the binary-search tree.
-     * @return a pointer to the successor node, or a NULL value
-     * if there is no successor.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Rebalances the ancestors of an unlinked position.
+     * @param tree the tree the node has been removed from.
+     * @param removed the node that has been unlinked.
+     * @param child the node that took the place of the unlinked position.
+     * @param parent the parent of `child`, from which heights have changed.
+     * @note Complexity is O(log(n)).
      */
-    node_t<T>* remove(node_t<T>* node, const T& data) {
-      if (!node)
-        return (nullptr);
-      
-      // Comparing the value associated with the nodes.
-      int result = this->options.compare(data, node->value());
-      
-      if (result < 0)
-        node->left = remove(node->left, data);
-      else if (result > 0)
-        node->right = remove(node->right, data);
-      else {
-        // The node doesn't have any children.
-        if (!node->left && !node->right) {
-          // If the node is the root, we need to set the root to nullptr.
-          if (this->root_ == node) this->root_ = nullptr;
-          delete node;
-          this->size_of_tree--;
-          return (nullptr);
-        // The node has one child.
-        } else if (!node->left || !node->right) {
-          // Finding the child node.
-          auto successor = node->right ? node->right : node->left;
-          // Setting the new parent of the child node.
-          successor->parent = node->parent;
-          // If the node is the root, the child node becomes the new root.
-          if (this->root_ == node) this->root_ = successor;
-          delete node;
-          this->size_of_tree--;
-          return (successor);
-        // The node has two children.
-        } else {
-          const auto successor = min(node->right);
-          node->data = successor->data;
-          node->right = remove(node->right, successor->data);
-        }
-      }
-      return (node);
+    template <typename Tree, typename Node>
+    void on_remove(Tree& tree, Node*, Node*, Node* parent) {
+      this->retrace(tree, parent);
     }
 
     /**
-     * @brief Removes the node associated with the given `data` from the binary-search tree.
-     * @param data the data to remove from the binary-search tree.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Computes the height of the nodes of a tree built balanced.
+     * @param tree the tree being built.
+     * @param node the node whose children have been built.
+     * @note Complexity is O(1).
      */
-    void remove(const T& data) {
-      remove(this->root_, data);
+    template <typename Tree, typename Node>
+    void on_build(Tree&, Node* node, size_t, size_t) {
+      update(node);
     }
-    
+
     /**
-     * @brief Clears the given subtree.
-     * @param node the root of the subtree to clear.
-     * @note Complexity is O(n) on average.
+     * @brief Lookups do not restructure AVL trees.
+     */
+    template <typename Tree, typename Node>
+    void on_access(Tree&, Node*) {}
+
+    /**
+     * @brief Joins two detached subtrees under a detached node, by
+     * linking the node along the spine of the higher subtree, next to
+     * a node at most one level higher than the other subtree, and
+     * rebalancing its ancestors.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
+     * @note Complexity is O(log(n)).
      */
-    void clear(node_t<T>* node) {
-      if (!node) return;
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      if (height(left) >= height(right)) {
+        auto target = height(right) + 1;
+        tree.graft(left, middle, right, RIGHT, [&] (const Node* node) { return (height(node) <= target); });
+      } else {
+        auto target = height(left) + 1;
+        tree.graft(right, middle, left, LEFT, [&] (const Node* node) { return (height(node) <= target); });
+      }
+      this->retrace(tree, middle);
+    }
 
-      // Recursively clear the left subtree.
-      clear(node->left);
-      clear(node->right);
+    private:
 
-      // Detaching the node from its parent.
-      if (node->parent && node->parent->left == node)
-        node->parent->left = nullptr;
-      if (node->parent && node->parent->right == node)
-        node->parent->right = nullptr;
+      /**
+       * @return the height of the given subtree.
+       */
+      template <typename Node>
+      static int height(const Node* node) {
+        return (node ? node->height : 0);
+      }
 
-      // Decremeneting the size of the tree.
-      this->size_of_tree--;
+      /**
+       * @brief Recomputes the height of the given node
+       * from the height of its children.
+       */
+      template <typename Node>
+      static void update(Node* node) {
+        node->height = 1 + std::max(height(node->left), height(node->right));
+      }
 
-      // If the node is the root, we need to assign
-      // the root to a null pointer type.
-      if (this->root_ == node) {
-        this->root_ = nullptr;
+      /**
+       * @brief Walks up the tree from the given node, updating
+       * heights and rotating every node which became unbalanced.
+       * @param tree the tree to rebalance.
+       * @param node the deepest node whose subtree has changed.
+       */
+      template <typename Tree, typename Node>
+      void retrace(Tree& tree, Node* node) {
+        while (node) {
+          int balance = height(node->left) - height(node->right);
+
+          if (balance > 1) {
+            // The left subtree is too high.
+            if (height(node->left->left) < height(node->left->right)) {
+              tree.rotate_left(node->left);
+              update(node->left->left);
+            }
+            tree.rotate_right(node);
+            update(node);
+            node = node->parent;
+          } else if (balance < -1) {
+            // The right subtree is too high.
+            if (height(node->right->right) < height(node->right->left)) {
+              tree.rotate_right(node->right);
+              update(node->right->right);
+            }
+            tree.rotate_left(node);
+            update(node);
+            node = node->parent;
+          }
+          update(node);
+          node = node->parent;
+        }
       }
-      delete node;
-    }
-    
+  };
+
+  /**
+   * @brief A balancing policy implementing a scapegoat tree. Nodes do not
+   * store any metadata, instead the tree keeps track of the largest size
+   * it reached since it was last rebuilt. Inserting a node deeper than
+   * log3/2(n) rebuilds the subtree of an ancestor whose children are
+   * unbalanced, and removing nodes until the tree shrinks below 2/3 of
+   * that size rebuilds the whole tree.
+   * @note Operations are O(log(n)) amortized, and nodes are
+   * as small as the nodes of unbalanced trees.
+   */
+  struct scapegoat_t {
+
     /**
-     * @brief Clears the binary-search tree.
-     * @return the number of nodes removed from the tree.
-     * @note Complexity is O(n) on average.
+     * @brief Scapegoat trees do not store any metadata in their nodes.
      */
-    void clear() {
-      this->clear(this->root_);
-    }
+    using metadata_t = no_metadata_t;
 
     /**
-     * @brief Looks-up the binary-search tree for the nodes
-     * associated with the given iterator.
-     * @param begin the iterator to the beginning of the iterable.
-     * @param end the iterator to the end of the iterable.
-     * @return a vector of optional pointers to the found nodes.
+     * @brief Rebuilds the subtree of the deepest unbalanced ancestor
+     * of a newly attached node, if the node is too deep.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
+     * @note Complexity is O(log(n)) amortized.
      */
-    template<typename Iterator>
-    auto find(Iterator begin, Iterator end) {
-      std::vector<std::optional<const node_t<T>*>> nodes;
+    template <typename Tree, typename Node>
+    void on_insert(Tree& tree, Node* node) {
+      // An empty tree may have been cleared.
+      this->max_size = tree.size() == 1 ? 1 : std::max(this->max_size, tree.size());
 
-      for (Iterator it = begin; it != end; ++it) {
-        nodes.push_back(find(*it));
+      size_t depth = 0;
+      for (auto ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+        depth++;
+      }
+      if (depth <= max_depth(tree.size())) {
+        return;
+      }
+
+      // Looking up an ancestor holding more than 2/3 of
+      // its subtree in the subtree of one of its children.
+      size_t size = 1;
+      for (auto child = node, parent = node->parent; parent; child = parent, parent = parent->parent) {
+        auto sibling     = parent->left == child ? parent->right : parent->left;
+        auto parent_size = size + 1 + Tree::count_nodes(sibling);
+
+        if (3 * size > 2 * parent_size) {
+          tree.rebuild(parent, parent_size);
+          return;
+        }
+        size = parent_size;
       }
-      return (nodes);
     }
 
     /**
-     * @brief Looks-up the binary-search tree for the nodes
-     * associated with the given variadic arguments.
-     * @param args the values to search for in the tree.
-     * @return an array of optional pointers to the found nodes.
+     * @brief Rebuilds the whole tree once it shrank below 2/3
+     * of the largest size it reached.
+     * @param tree the tree the node has been removed from.
+     * @note Complexity is O(1) amortized.
      */
-    template <class... Args, typename = typename std::enable_if<all_of_type<T, Args...>::value>::type>
-    auto find(Args const& ... args) {
-      size_t idx = 0;
-      std::array<
-        std::optional<const node_t<T>*>, sizeof...(Args)
-      > nodes = {};
-
-      // The callable function inserts the results
-      // of the find operation into the array.
-      auto callable = [&] (const T& arg) {
-        nodes[idx++] = this->find(arg);
-      };
+    template <typename Tree, typename Node>
+    void on_remove(Tree& tree, Node*, Node*, Node*) {
+      if (3 * tree.size() < 2 * this->max_size) {
+        if (tree.root_) {
+          tree.rebuild(tree.root_, tree.size());
+        }
+        this->max_size = tree.size();
+      }
+    }
 
-      (callable(std::forward<Args>(args)),...);
-      return (nodes);
+    /**
+     * @brief Resets the largest size of a tree built balanced.
+     * @param tree the tree being built.
+     * @param depth the depth of the node.
+     */
+    template <typename Tree, typename Node>
+    void on_build(Tree& tree, Node*, size_t depth, size_t) {
+      // Subtrees may be built in parallel, the root being built last.
+      if (depth == 0) {
+        this->max_size = tree.size();
+      }
     }
 
     /**
-     * @brief Recursively traverse the subtree to find
-     * the node associated with the given `data`.
-     * @param node the node to start the traversal from.
-     * @param data the data to find in the given subtree.
-     * @return an optional pointer to the found node.
-     * @note Complexity is O(log(n)) on average, O(n) in the worst case.
+     * @brief Lookups do not restructure scapegoat trees.
      */
-    std::optional<const node_t<T>*> find(const node_t<T>* node, const T& data) const {
-      /* Ensure that the node and the given data are valid. */
-      if (!node) {
-        return {};
-      }
+    template <typename Tree, typename Node>
+    void on_access(Tree&, Node*) {}
+
+    /**
+     * @brief Joins two detached subtrees by making the detached node
+     * their parent, later insertions rebuilding the subtrees which
+     * became too deep.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
+     * @note Complexity is O(1).
+     */
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      tree.graft(left, middle, right, RIGHT, [] (const Node*) { return (true); });
+    }
 
-      /* Comparing the value associated with the nodes. */
-      auto result = this->options.compare(data, node->value());
+    private:
+      size_t max_size = 0;
 
-      if (result < 0) {
-        return (find(node->left, data));
-      } else if (result > 0) {
-        return (find(node->right, data));
-      } else {
-        return (node);
+      /**
+       * @return the maximum depth of the nodes of a tree of the
+       * given size, i.e log3/2(size).
+       */
+      static size_t max_depth(size_t size) {
+        return (static_cast<size_t>(std::log(static_cast<double>(size)) / std::log(1.5)));
       }
-    }
+  };
+
+  /**
+   * @brief A balancing policy implementing a splay tree. Inserted and
+   * looked up nodes are moved to the root through rotations, which keeps
+   * frequently accessed values close to the root. Nodes do not store
+   * any metadata.
+   * @note Operations are O(log(n)) amortized, and a sequence of lookups
+   * costs O(log(1/p)) amortized per lookup of a value accessed with
+   * frequency `p`. Lookups on a const tree do not restructure it.
+   */
+  struct splay_t {
 
     /**
-     * @brief A method finding the node associated with `data`
-     * in the binary-search tree.
-     * @param data a reference to the data to look up.
-     * @return a pointer to the node containing the data, or NULL if the node
-     * was not found.
-     * @note Complexity is O(log(n)) on average, O(n) in the worst case.
+     * @brief Splay trees do not store any metadata in their nodes.
      */
-    std::optional<const node_t<T>*> find(const T& data) const {
-      return (this->find(this->root_, data));
-    }
+    using metadata_t = no_metadata_t;
 
     /**
-     * @brief Recursively traverse the given subtree to find
-     * the node associated with the smallest value.
-     * @param node the node to start the traversal from.
-     * @return a pointer to the node associated with the smallest value.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Moves a newly attached node to the root.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
+     * @note Complexity is O(log(n)) amortized.
      */
-    const node_t<T>* min(const node_t<T>* node) const {
-      while (node && node->left != nullptr)
-        node = node->left;
-      return (node);
-    } 
+    template <typename Tree, typename Node>
+    void on_insert(Tree& tree, Node* node) {
+      splay(tree, node);
+    }
 
     /**
-     * @brief Recursively traverse the binary-search tree to find
-     * the node associated with the smallest value.
-     * @return a pointer to the node associated with the smallest value.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Moves the parent of an unlinked position to the root.
+     * @param tree the tree the node has been removed from.
+     * @param parent the parent of the unlinked position.
+     * @note Complexity is O(log(n)) amortized.
      */
-    const node_t<T>* min() const {
-      return (this->min(this->root_));
+    template <typename Tree, typename Node>
+    void on_remove(Tree& tree, Node*, Node*, Node* parent) {
+      if (parent) {
+        splay(tree, parent);
+      }
     }
 
     /**
-     * @brief Recursively traverse the given subtree to find
-     * the node associated with the biggest value.
-     * @param node the node to start the traversal from.
-     * @return a pointer to the node associated with the biggest value.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Trees built balanced do not need any metadata.
      */
-    const node_t<T>* max(const node_t<T>* node) const {
-      while (node && node->right != nullptr)
-        node = node->right;
-      return (node);
-    }
-    
+    template <typename Tree, typename Node>
+    void on_build(Tree&, Node*, size_t, size_t) {}
+
     /**
-     * @brief Recursively traverse the binary-search tree to find
-     * the node associated with the biggest value.
-     * @return a pointer to the node associated with the biggest value.
-     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     * @brief Moves an accessed node to the root.
+     * @param tree the tree the node belongs to.
+     * @param node the node that has been accessed.
+     * @note Complexity is O(log(n)) amortized.
      */
-    const node_t<T>* max() const {
-      return (this->max(this->root_));
+    template <typename Tree, typename Node>
+    void on_access(Tree& tree, Node* node) {
+      splay(tree, node);
     }
 
     /**
-     * @return the number of nodes contained by the
-     * binary search tree.
+     * @brief Joins two detached subtrees by making the detached node
+     * their parent, as if it had just been splayed.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
+     * @note Complexity is O(1).
      */
-    size_t size() const {
-      return (this->size_of_tree);
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      tree.graft(left, middle, right, RIGHT, [] (const Node*) { return (true); });
     }
 
+    private:
+
+      /**
+       * @brief Rotates the parent of the given node, so that
+       * the node takes its place.
+       */
+      template <typename Tree, typename Node>
+      static void rotate_up(Tree& tree, Node* node) {
+        if (node == node->parent->left)
+          tree.rotate_right(node->parent);
+        else
+          tree.rotate_left(node->parent);
+      }
+
+      /**
+       * @brief Moves the given node to the root by rotating pairs of
+       * ancestors, which roughly halves the depth of the nodes on its path.
+       * @param tree the tree the node belongs to.
+       * @param node the node to move to the root.
+       */
+      template <typename Tree, typename Node>
+      static void splay(Tree& tree, Node* node) {
+        while (node->parent) {
+          auto parent      = node->parent;
+          auto grandparent = parent->parent;
+
+          if (!grandparent) {
+            // Zig: the parent is the root.
+            rotate_up(tree, node);
+          } else if ((node == parent->left) == (parent == grandparent->left)) {
+            // Zig-zig: the node and its parent are outer children.
+            rotate_up(tree, parent);
+            rotate_up(tree, node);
+          } else {
+            // Zig-zag: the node is an inner grandchild.
+            rotate_up(tree, node);
+            rotate_up(tree, node);
+          }
+        }
+      }
+  };
+
+  /**
+   * @brief A balancing policy augmenting the nodes of another policy
+   * with the size of their subtree, which lets the tree select values
+   * by rank and rank values in O(log(n)).
+   * @tparam Balance the balancing policy restructuring the tree.
+   * @note The policy updates the ancestors of attached and unlinked
+   * positions, while the tree keeps sizes up-to-date across rotations.
+   */
+  template <typename Balance = unbalanced_t>
+  struct order_statistic_t {
+
     /**
-     * @return a pointer to the root node of the tree.
+     * The augmented balancing policy.
      */
-    const node_t<T>* root() const {
-      return (this->root_);
-    }
+    using balance_type = Balance;
 
     /**
-     * @return a string representation of the binary-search tree.
-     * @param node the node to start the traversal from.
-     * @param result the string to append the result to.
-     * @param prefix the prefix to use for each line.
-     * @note Complexity is O(n) on average, O(n) on the worst case.
+     * @brief Nodes store the metadata of the augmented policy
+     * along with the number of nodes in their subtree.
      */
-    const std::string to_string(const node_t<T>* node, std::string result = "", std::string prefix = "") const {
-      if (!node) {
-        // We reached the end of a subtree.
-        return (result);
-      }
-      // Concatenate the prefix with the current node's data.
-      result += prefix + "├──" + this->options.to_string(node->value()) + "\n";
-      // Whether the current node is the left child of its parent.
-      bool isRight = node->parent && node->parent->right == node;
-      // A separator to display between the current node's children.
-      std::string separator = isRight ? "│  " : "   ";
-      // Recursively display the left children.
-      result = to_string(node->right, result, prefix + separator);
-      // Recursively display the left children.
-      result = to_string(node->left, result, prefix + separator);
-      return (result);
+    struct metadata_t : public Balance::metadata_t {
+      size_t size = 1;
+    };
+
+    /**
+     * @brief Accounts for a newly attached node in its ancestors,
+     * and lets the augmented policy rebalance the tree.
+     * @param tree the tree the node has been attached to.
+     * @param node the newly attached node.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    template <typename Tree, typename Node>
+    void on_insert(Tree& tree, Node* node) {
+      node->size = 1;
+      for (auto ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+        ancestor->size++;
+      }
+      this->balance.on_insert(tree, node);
     }
-    
+
     /**
-     * @return a string representation of the binary-search tree.
+     * @brief Accounts for an unlinked position in its ancestors,
+     * and lets the augmented policy rebalance the tree.
+     * @param tree the tree the node has been removed from.
+     * @param removed the node that has been unlinked.
+     * @param child the node that took the place of the unlinked position.
+     * @param parent the parent of `child`.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
      */
-    const std::string to_string() const {
-      return (this->to_string(this->root_));
+    template <typename Tree, typename Node>
+    void on_remove(Tree& tree, Node* removed, Node* child, Node* parent) {
+      for (auto ancestor = parent; ancestor; ancestor = ancestor->parent) {
+        ancestor->size--;
+      }
+      this->balance.on_remove(tree, removed, child, parent);
     }
 
     /**
-     * @brief Outputs a string representation of the binary-search tree
-     * to the given stream.
-     * @param stream the stream to output the string representation to.
-     * @param tree the binary-search tree to output.
-     * @return a reference to the stream.
+     * @brief Lets the augmented policy initialize the nodes of a tree
+     * built balanced, whose sizes are computed by the tree.
+     * @param tree the tree being built.
+     * @param node the node whose children have been built.
+     * @param depth the depth of the node.
+     * @param max_depth the depth of the deepest leaves of the tree.
      */
-    friend std::ostream& operator<<(std::ostream& stream, const tree_t<T>& tree) {
-      stream << tree.to_string();
-      return (stream);
+    template <typename Tree, typename Node>
+    void on_build(Tree& tree, Node* node, size_t depth, size_t max_depth) {
+      this->balance.on_build(tree, node, depth, max_depth);
     }
-    
+
     /**
-     * @return an iterator to the first node in the binary-search tree.
-     * @note Uses the depth-first search iterator by default.
+     * @brief Lets the augmented policy restructure the tree on lookups.
+     * @param tree the tree the node belongs to.
+     * @param node the node that has been accessed.
      */
-    const_iterator begin() const {
-      return (DefaultIterator(this->min(), this));
+    template <typename Tree, typename Node>
+    void on_access(Tree& tree, Node* node) {
+      this->balance.on_access(tree, node);
     }
 
     /**
-     * @return an iterator to the last node in the binary-search tree.
-     * @note Uses the depth-first search iterator by default.
+     * @brief Lets the augmented policy join two detached subtrees,
+     * whose sizes are updated by the tree.
+     * @param tree the tree the subtrees are joined in.
+     * @param left the root of the lower subtree, can be null.
+     * @param middle the node to join the subtrees with.
+     * @param right the root of the upper subtree, can be null.
      */
-    const_iterator end() const {
-      return (DefaultIterator(nullptr, this));
+    template <typename Tree, typename Node>
+    void on_join(Tree& tree, Node* left, Node* middle, Node* right) {
+      this->balance.on_join(tree, left, middle, right);
     }
 
     private:
-      node_t<T>* root_;
-      size_t size_of_tree;
-      options_t<T> options;
-
-      /**
-       * @brief A helper function to attach a node to another node.
-       * @param node the node to attach the new node to.
-       * @param data the data to associate with the new node.
-       * @param direction whether the new node should be attached to the left or right.
-       * @return a pointer to the newly attached node.
-       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
-       */
-      node_t<T>* attach(node_t<T>* node, const T& data, direction_t direction) {
-        auto new_node = new node_t<T>(data);
+      Balance balance;
+  };
 
-        direction == LEFT ? node->left = new_node : node->right = new_node;
-        new_node->parent = node;
-        new_node->tree = this;
-        this->size_of_tree++;
-        return (new_node);
-      }
+  /**
+   * @brief Detects node metadata storing the size of their subtree.
+   */
+  template <typename Metadata, typename = void>
+  struct has_subtree_size : std::false_type {};
 
-      /**
-       * @brief Inserts a new node into the given subtree.
-       * @param node the root of the subtree to insert the node into.
-       * @param data the data to associate with the new node.
-       * @return a pointer to the newly inserted node.
-       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
-       */
-      node_t<T>* insert(node_t<T>* node, const T& data) {
-        // Comparing the new node's value with the current node's value.
-        auto result = this->options.compare(data, node->value());
+  template <typename Metadata>
+  struct has_subtree_size<Metadata, std::void_t<decltype(std::declval<Metadata&>().size)>> : std::true_type {};
 
-        if (result < 0) {
-          return (node->left ? insert(node->left, data) : attach(node, data, LEFT));
-        } else if (result > 0) {
-          return (node->right ? insert(node->right, data) : attach(node, data, RIGHT));
-        } else {
-          return (NULL);
-        }
-      }
+  /**
+   * @brief Resolves the policy performing rotations, which is the
+   * augmented policy when a policy wraps another one.
+   */
+  template <typename Balance, typename = void>
+  struct balance_of {
+    using type = Balance;
   };
 
-  // Definition of the depth-first search iterator.
-  template <typename T>
-  class dfs_iterator_t : public std::iterator<std::bidirectional_iterator_tag, T> {
+  template <typename Balance>
+  struct balance_of<Balance, std::void_t<typename Balance::balance_type>> {
+    using type = typename Balance::balance_type;
+  };
 
-    // Iterator members.
-    const node_t<T>* ptr;
-    const tree_t<T>* tree;
+  /**
+   * @brief A pool of fixed-size slots carved out of large contiguous
+   * blocks. Freed slots are recycled through an intrusive free list,
+   * and blocks are only returned to the system when the pool is destroyed.
+   */
+  class fixed_pool_t {
 
     public:
 
       /**
-       * @brief Construct a new depth-first iterator.
-       * @param node the node to start the iteration from.
-       * @param tree the tree to iterate over.
+       * @brief Creates a new pool of slots.
+       * @param size the size of the objects stored in the slots.
+       * @param alignment the alignment of the objects stored in the slots.
+       * @param slots_per_block the number of slots carved out of each block.
        */
-      dfs_iterator_t(const node_t<T>* node, const tree_t<T>* tree): ptr{node}, tree{tree} {}
+      fixed_pool_t(size_t size, size_t alignment, size_t slots_per_block) :
+        size_{size},
+        alignment_{alignment},
+        slot_alignment{std::max(alignment, alignof(void*))},
+        slot_size{(std::max(size, sizeof(void*)) + slot_alignment - 1) / slot_alignment * slot_alignment},
+        slots_per_block{slots_per_block},
+        free_list{nullptr},
+        cursor{nullptr},
+        end{nullptr} {}
 
       /**
-       * @brief Construct a new depth-first iterator.
+       * Copy-constructor is deleted.
        */
-      dfs_iterator_t(): ptr{nullptr}, tree{nullptr} {}
+      fixed_pool_t(const fixed_pool_t&) = delete;
 
       /**
-       * @brief Compares two iterators for equality.
-       * @param other the iterator to compare with.
-       * @return true if the iterators are equal, false otherwise.
+       * Assignment operator is deleted.
        */
-      bool operator==(const dfs_iterator_t& other) const {
-        return (this->tree == other.tree && this->ptr == other.ptr);
-      }
+      fixed_pool_t& operator=(const fixed_pool_t&) = delete;
 
       /**
-       * @brief Compares two iterators for inequality.
-       * @param other the iterator to compare with.
-       * @return true if the iterators are not equal, false otherwise.
+       * @brief Releases the blocks owned by the pool.
        */
-      bool operator!=(const dfs_iterator_t& other) const {
-        return (this->tree != other.tree || this->ptr != other.ptr);
+      ~fixed_pool_t() {
+        for (auto block : this->blocks) {
+          ::operator delete(block, std::align_val_t(this->slot_alignment));
+        }
       }
 
       /**
-       * @brief De-references the iterator.
-       * @return the value of the node currently iterated over.
-       * If the iteration ended, an exception is thrown.
+       * @return a pointer to an uninitialized slot.
+       * @note Complexity is O(1).
        */
-      const T& operator*() const {
-        if (!this->ptr) {
-            throw std::out_of_range("Iterator is out of range");
+      void* allocate() {
+        // Recycling a previously freed slot.
+        if (this->free_list) {
+          void* slot = this->free_list;
+          this->free_list = *static_cast<void**>(slot);
+          return (slot);
         }
-        return (this->ptr->value());
-      }
-  
-      /**
-       * @brief Increments the iterator.
-       * @return a reference to the iterator.
-       */
-      dfs_iterator_t& operator++() {
-        if (this->ptr == nullptr) {
-          // Initialize the node pointer to the root node of the tree.
-          this->ptr = this->tree->root_;
-          // If the tree is empty, we raise an exception.
-          if (!this->ptr) {
-            throw std::out_of_range("Iterator is out of range");
-          }
-          // Initializing the node to the smallest node
-          // in the binary search tree.
-          this->ptr = this->tree->min(this->ptr);
-        } else {
-          // If a right node exist, we iterate right,
-          // and we iterate again to the node with the smallest value.
-          if (this->ptr->right) {
-            this->ptr = this->tree->min(this->ptr->right);
-          } else {
-            auto node = this->ptr->parent;
-            // If no right node exists, we iterate upwards until
-            // we find a node with a left node.
-            while (node && this->ptr == node->right) {
-              this->ptr = node;
-              node = node->parent;
-            }
-            this->ptr = node;
-          }
+
+        // Allocating a new block when the current one is exhausted.
+        if (this->cursor == this->end) {
+          auto size  = this->slot_size * this->slots_per_block;
+          auto block = static_cast<char*>(::operator new(size, std::align_val_t(this->slot_alignment)));
+          this->blocks.push_back(block);
+          this->cursor = block;
+          this->end    = block + size;
         }
-        return (*this);
+
+        void* slot = this->cursor;
+        this->cursor += this->slot_size;
+        return (slot);
       }
 
       /**
-       * @brief Postfix increment operator.
-       * @return a copy of the iterator before incrementing it.
+       * @brief Gives a slot back to the pool.
+       * @param slot the slot to recycle.
+       * @note Complexity is O(1).
        */
-      dfs_iterator_t operator++(int) {
-        dfs_iterator_t<T> tmp = *this;
-        ++(*this);
-        return (tmp);
+      void deallocate(void* slot) {
+        *static_cast<void**>(slot) = this->free_list;
+        this->free_list = slot;
       }
 
       /**
-       * @brief Decrements the iterator.
-       * @return a reference to the iterator.
+       * @return the size of the objects stored in the slots.
        */
-      dfs_iterator_t& operator--() {
-        if (this->ptr == nullptr) {
-          // Initialize the node pointer to the root node of the tree.
-          this->ptr = this->tree->root;
-          // If the tree is empty, we raise an exception.
-          if (!this->ptr) {
-            throw std::out_of_range("Iterator is out of range");
-          }
-          // Initializing the node to the biggest node
-          // in the binary search tree.
-          this->ptr = this->tree->max(this->ptr);
-        } else {
-          // If a left node exist, we iterate left,
-          // and we iterate until we find the node with
-          // the biggest value in the left subtree.
-          if (this->ptr->left) {
-            this->ptr = this->tree->max(this->ptr->left);
-          } else {
-            auto node = this->ptr->parent;
-            // If no left node exists, we iterate upwards until
-            // we find a node with a right node.
-            while (node && this->ptr == node->left) {
-              this->ptr = node;
-              node = node->parent;
-            }
-            this->ptr = node;
-          }
-        }
-        return (*this);
+      size_t size() const {
+        return (this->size_);
       }
 
       /**
-       * @brief Postfix decrement operator.
-       * @return a copy of the iterator before decrementing it.
+       * @return the alignment of the objects stored in the slots.
        */
-      dfs_iterator_t operator--(int) {
-        dfs_iterator_t<T> tmp = *this;
-        --(*this);
-        return (tmp);
+      size_t alignment() const {
+        return (this->alignment_);
       }
+
+    private:
+      size_t size_;
+      size_t alignment_;
+      size_t slot_alignment;
+      size_t slot_size;
+      size_t slots_per_block;
+      void*  free_list;
+      char*  cursor;
+      char*  end;
+      std::vector<char*> blocks;
   };
 
   /**
-   * @brief Describes a binary-search tree node
-   * attributes.
+   * @brief A memory resource holding the pools shared by
+   * all the rebound copies of a `pool_allocator_t`.
+   * @note The resource is not thread-safe, just like the tree using it.
    */
-  template <typename T>
-  struct node_t {
+  class pool_resource_t {
 
-    /**
-     * @brief Node constructor.
-     * @param data The data to be stored in the node.
+    public:
+
+      /**
+       * @brief Creates a new pool resource.
+       * @param slots_per_block the number of slots carved out of each block.
+       */
+      explicit pool_resource_t(size_t slots_per_block = 1024) :
+        slots_per_block{slots_per_block} {}
+
+      /**
+       * @brief Looks up the pool serving objects of the given
+       * size and alignment, creating it if necessary.
+       * @param size the size of the objects in bytes.
+       * @param alignment the alignment of the objects in bytes.
+       * @return a pointer to the pool.
+       */
+      fixed_pool_t* pool_for(size_t size, size_t alignment) {
+        for (auto& pool : this->pools) {
+          if (pool->size() == size && pool->alignment() == alignment) {
+            return (pool.get());
+          }
+        }
+        this->pools.push_back(std::make_unique<fixed_pool_t>(size, alignment, this->slots_per_block));
+        return (this->pools.back().get());
+      }
+
+    private:
+      size_t slots_per_block;
+      std::vector<std::unique_ptr<fixed_pool_t>> pools;
+  };
+
+  /**
+   * @brief A standard-compatible allocator serving single objects
+   * from a `pool_resource_t`. Larger allocations are forwarded
+   * to `std::allocator`. Copies and rebound copies of an allocator
+   * share the same resource.
+   */
+  template <typename T>
+  struct pool_allocator_t {
+
+    /**
+     * Rebound allocators share the resource of the allocator
+     * they are created from.
      */
-    node_t(const T& data) :
-      data{data}, left{nullptr}, right{nullptr}, parent{nullptr}, tree{nullptr} {}
+    template <typename U>
+    friend struct pool_allocator_t;
+
+    using value_type = T;
 
     /**
-     * @brief Node move constructor.
-     * @param data The data to be moved to the node.
+     * @brief Creates an allocator backed by a new resource.
      */
-    node_t(const T&& data) :
-      data{std::move(data)}, left{nullptr}, right{nullptr}, parent{nullptr}, tree{nullptr} {}
+    pool_allocator_t() : pool_allocator_t(std::make_shared<pool_resource_t>()) {}
 
     /**
-     * @return a reference to the data stored by the node.
+     * @brief Creates an allocator backed by the given resource.
+     * @param resource the resource to allocate objects from.
      */
-    const T& value() const {
-      return (this->data);
+    explicit pool_allocator_t(std::shared_ptr<pool_resource_t> resource) :
+      resource{resource}, pool{resource->pool_for(sizeof(T), alignof(T))} {}
+
+    /**
+     * @brief Creates an allocator sharing the resource of
+     * the given allocator.
+     * @param other the allocator to rebind.
+     */
+    template <typename U>
+    pool_allocator_t(const pool_allocator_t<U>& other) :
+      pool_allocator_t(other.resource) {}
+
+    /**
+     * @brief Allocates storage for `n` objects.
+     * @param n the number of objects.
+     * @return a pointer to the uninitialized storage.
+     */
+    T* allocate(size_t n) {
+      if (n != 1) {
+        return (std::allocator<T>().allocate(n));
+      }
+      return (static_cast<T*>(this->pool->allocate()));
+    }
+
+    /**
+     * @brief Deallocates storage for `n` objects.
+     * @param ptr a pointer to the storage.
+     * @param n the number of objects.
+     */
+    void deallocate(T* ptr, size_t n) {
+      if (n != 1) {
+        return (std::allocator<T>().deallocate(ptr, n));
+      }
+      this->pool->deallocate(ptr);
+    }
+
+    /**
+     * @return whether two allocators share the same resource.
+     */
+    template <typename U>
+    bool operator==(const pool_allocator_t<U>& other) const {
+      return (this->resource == other.resource);
+    }
+
+    /**
+     * @return whether two allocators use different resources.
+     */
+    template <typename U>
+    bool operator!=(const pool_allocator_t<U>& other) const {
+      return (this->resource != other.resource);
+    }
+
+    private:
+      std::shared_ptr<pool_resource_t> resource;
+      fixed_pool_t* pool;
+  };
+
+  /**
+   * @brief A monotonic memory resource carving objects out of
+   * geometrically growing blocks. Objects are never freed individually,
+   * instead all the blocks are released at once.
+   * @note The resource is not thread-safe, just like the tree using it.
+   */
+  class arena_resource_t {
+
+    public:
+
+      /**
+       * @brief Creates a new arena.
+       * @param block_size the size of the first block in bytes.
+       */
+      explicit arena_resource_t(size_t block_size = 64 * 1024) :
+        initial_block_size{block_size}, block_size{block_size}, cursor{nullptr}, end{nullptr} {}
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      arena_resource_t(const arena_resource_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      arena_resource_t& operator=(const arena_resource_t&) = delete;
+
+      /**
+       * @brief Releases the blocks owned by the arena.
+       */
+      ~arena_resource_t() {
+        this->release();
+      }
+
+      /**
+       * @brief Allocates uninitialized storage from the arena.
+       * @param size the size of the storage in bytes.
+       * @param alignment the alignment of the storage in bytes.
+       * @return a pointer to the storage.
+       * @note Complexity is O(1).
+       */
+      void* allocate(size_t size, size_t alignment) {
+        auto ptr = align(this->cursor, alignment);
+
+        // Allocating a new block when the current one is exhausted.
+        if (!ptr || ptr + size > this->end) {
+          auto capacity = std::max(this->block_size, size + alignment);
+          auto block    = static_cast<char*>(::operator new(capacity));
+          this->blocks.push_back(block);
+          this->block_size *= 2;
+          this->end = block + capacity;
+          ptr = align(block, alignment);
+        }
+
+        this->cursor = ptr + size;
+        return (ptr);
+      }
+
+      /**
+       * @brief Releases all the storage allocated from the arena at once.
+       * @note Complexity is O(log(n)) in the number of allocated bytes.
+       */
+      void release() {
+        for (auto block : this->blocks) {
+          ::operator delete(block);
+        }
+        this->blocks.clear();
+        this->block_size = this->initial_block_size;
+        this->cursor = nullptr;
+        this->end    = nullptr;
+      }
+
+    private:
+      size_t initial_block_size;
+      size_t block_size;
+      char*  cursor;
+      char*  end;
+      std::vector<char*> blocks;
+
+      /**
+       * @return the given pointer aligned up to the given alignment.
+       */
+      static char* align(char* ptr, size_t alignment) {
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        return (ptr + ((alignment - address % alignment) % alignment));
+      }
+  };
+
+  /**
+   * @brief A standard-compatible allocator carving objects out of an
+   * `arena_resource_t`. Deallocation is a no-op, and trees using this
+   * allocator release all their nodes at once when cleared.
+   * @note An arena must not be shared by several trees, since clearing
+   * one of them releases the nodes of all the others.
+   */
+  template <typename T>
+  struct arena_allocator_t {
+
+    /**
+     * Rebound allocators share the arena of the allocator
+     * they are created from.
+     */
+    template <typename U>
+    friend struct arena_allocator_t;
+
+    using value_type = T;
+
+    /**
+     * @brief Creates an allocator backed by a new arena.
+     */
+    arena_allocator_t() : resource{std::make_shared<arena_resource_t>()} {}
+
+    /**
+     * @brief Creates an allocator backed by the given arena.
+     * @param resource the arena to allocate objects from.
+     */
+    explicit arena_allocator_t(std::shared_ptr<arena_resource_t> resource) :
+      resource{resource} {}
+
+    /**
+     * @brief Creates an allocator sharing the arena of
+     * the given allocator.
+     * @param other the allocator to rebind.
+     */
+    template <typename U>
+    arena_allocator_t(const arena_allocator_t<U>& other) :
+      resource{other.resource} {}
+
+    /**
+     * @brief Allocates storage for `n` objects.
+     * @param n the number of objects.
+     * @return a pointer to the uninitialized storage.
+     */
+    T* allocate(size_t n) {
+      return (static_cast<T*>(this->resource->allocate(n * sizeof(T), alignof(T))));
+    }
+
+    /**
+     * @brief Storage is only reclaimed when the arena is released.
+     */
+    void deallocate(T*, size_t) {}
+
+    /**
+     * @brief Releases all the storage allocated from the arena.
+     */
+    void release() {
+      this->resource->release();
+    }
+
+    /**
+     * @return whether two allocators share the same arena.
+     */
+    template <typename U>
+    bool operator==(const arena_allocator_t<U>& other) const {
+      return (this->resource == other.resource);
+    }
+
+    /**
+     * @return whether two allocators use different arenas.
+     */
+    template <typename U>
+    bool operator!=(const arena_allocator_t<U>& other) const {
+      return (this->resource != other.resource);
     }
 
-    T          data;
-    node_t<T>* left;
-    node_t<T>* right;
-    node_t<T>* parent;
-    tree_t<T>* tree;
+    private:
+      std::shared_ptr<arena_resource_t> resource;
+  };
+
+  /**
+   * @brief Detects allocators able to release all their
+   * allocations at once.
+   */
+  template <typename Allocator, typename = void>
+  struct is_releasable : std::false_type {};
+
+  template <typename Allocator>
+  struct is_releasable<Allocator, std::void_t<decltype(std::declval<Allocator&>().release())>> : std::true_type {};
+
+  /**
+   * @brief A pool of worker threads running the halves of divide-and-conquer
+   * algorithms. A thread forking a task runs it itself when no worker picked
+   * it up by the time its result is needed, so that forks can be nested
+   * without the workers waiting on each other.
+   */
+  class thread_pool_t {
+
+    public:
+
+      /**
+       * @brief Creates a new pool of threads.
+       * @param workers the number of worker threads, the threads forking
+       * tasks taking part in their execution. A pool without workers
+       * runs every task sequentially.
+       */
+      explicit thread_pool_t(size_t workers = std::max(std::thread::hardware_concurrency(), 1u) - 1) {
+        for (size_t i = 0; i < workers; ++i) {
+          this->workers.emplace_back([this] { this->work(); });
+        }
+      }
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      thread_pool_t(const thread_pool_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      thread_pool_t& operator=(const thread_pool_t&) = delete;
+
+      /**
+       * @brief Waits for the workers to run the pending tasks, and joins them.
+       */
+      ~thread_pool_t() {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->stopping = true;
+        }
+        this->available.notify_all();
+        for (auto& worker : this->workers) {
+          worker.join();
+        }
+      }
+
+      /**
+       * @return the number of worker threads.
+       */
+      size_t size() const {
+        return (this->workers.size());
+      }
+
+      /**
+       * @brief Runs the given functions in parallel, `right` being offered
+       * to the workers while the calling thread runs `left`.
+       * @param left the function run by the calling thread.
+       * @param right the function offered to the workers.
+       * @throws the first exception thrown by `left`, or by `right`,
+       * once both functions have returned.
+       */
+      template <typename Left, typename Right>
+      void fork_join(Left&& left, Right&& right) {
+        if (this->workers.empty()) {
+          left();
+          right();
+          return;
+        }
+
+        task_t task{std::function<void()>(std::forward<Right>(right))};
+        std::exception_ptr error;
+
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->tasks.push_back(&task);
+        }
+        this->available.notify_one();
+
+        try {
+          left();
+        } catch (...) {
+          error = std::current_exception();
+        }
+
+        // Running the task if no worker picked it up, or waiting for it.
+        std::unique_lock<std::mutex> lock(this->mutex);
+        auto pending = std::find(this->tasks.rbegin(), this->tasks.rend(), &task);
+
+        if (pending != this->tasks.rend()) {
+          this->tasks.erase(std::next(pending).base());
+          lock.unlock();
+          run(task);
+        } else {
+          this->completed.wait(lock, [&] { return (task.done); });
+        }
+
+        if (error) {
+          std::rethrow_exception(error);
+        }
+        if (task.error) {
+          std::rethrow_exception(task.error);
+        }
+      }
+
+    private:
+
+      /**
+       * @brief Describes a task offered to the workers.
+       */
+      struct task_t {
+        std::function<void()> function;
+        std::exception_ptr error = nullptr;
+        bool done = false;
+      };
+
+      std::mutex mutex;
+      std::condition_variable available;
+      std::condition_variable completed;
+      std::deque<task_t*> tasks;
+      std::vector<std::thread> workers;
+      bool stopping = false;
+
+      /**
+       * @brief Runs the given task, keeping track of its exception.
+       */
+      static void run(task_t& task) {
+        try {
+          task.function();
+        } catch (...) {
+          task.error = std::current_exception();
+        }
+      }
+
+      /**
+       * @brief The loop of the workers, running the oldest
+       * pending task, which is usually the largest one.
+       */
+      void work() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (true) {
+          this->available.wait(lock, [this] { return (this->stopping || !this->tasks.empty()); });
+          if (this->tasks.empty()) {
+            return;
+          }
+
+          auto task = this->tasks.front();
+          this->tasks.pop_front();
+          lock.unlock();
+          run(*task);
+          lock.lock();
+          task->done = true;
+          this->completed.notify_all();
+        }
+      }
+  };
+
+  /**
+   * @return the thread pool shared by the set operations of the trees,
+   * created on first use with one worker per additional hardware thread.
+   */
+  inline thread_pool_t& default_thread_pool() {
+    static thread_pool_t pool;
+    return (pool);
+  }
+
+  /**
+   * @brief A domain of epoch-based memory reclamation, deferring the
+   * destruction of the objects unlinked from a shared structure until
+   * no thread may still be reading them.
+   *
+   * Threads pin themselves to the global epoch while they read the
+   * structure, and objects are retired in the epoch they are unlinked in.
+   * The global epoch only advances once every pinned thread observed it,
+   * so that objects retired two epochs ago cannot be reached anymore.
+   * Every thread keeps its own list of retired objects, which it
+   * reclaims every `batch` retirements.
+   */
+  class epoch_domain_t {
+
+      struct participant_t;
+
+    public:
+
+      /**
+       * @brief Pins the calling thread to the current epoch for its lifetime,
+       * the objects it reads not being destroyed in the meantime.
+       * Guards can be nested.
+       */
+      class guard_t {
+
+        public:
+
+          /**
+           * @brief Pins the calling thread.
+           * @param domain the domain to pin the thread in.
+           */
+          explicit guard_t(epoch_domain_t& domain): participant{domain.participant()} {
+            if (this->participant.nesting++ == 0) {
+              auto epoch = domain.state->epoch.load(std::memory_order_relaxed);
+              this->participant.announced.store((epoch << 1) | ACTIVE, std::memory_order_relaxed);
+              std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+          }
+
+          /**
+           * Copy-constructor is deleted.
+           */
+          guard_t(const guard_t&) = delete;
+
+          /**
+           * Assignment operator is deleted.
+           */
+          guard_t& operator=(const guard_t&) = delete;
+
+          /**
+           * @brief Unpins the calling thread.
+           */
+          ~guard_t() {
+            if (--this->participant.nesting == 0) {
+              auto announced = this->participant.announced.load(std::memory_order_relaxed);
+              this->participant.announced.store(announced & ~ACTIVE, std::memory_order_release);
+            }
+          }
+
+        private:
+
+          participant_t& participant;
+      };
+
+      /**
+       * @brief Creates a new reclamation domain.
+       * @param batch the number of objects a thread retires between
+       * two attempts to reclaim them.
+       */
+      explicit epoch_domain_t(size_t batch = 64): state{std::make_shared<state_t>()}, batch{std::max<size_t>(batch, 1)} {}
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      epoch_domain_t(const epoch_domain_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      epoch_domain_t& operator=(const epoch_domain_t&) = delete;
+
+      /**
+       * @brief Destroys the objects that are still retired, which
+       * requires no thread to be pinned in the domain.
+       */
+      ~epoch_domain_t() = default;
+
+      /**
+       * @return a guard pinning the calling thread to the current epoch.
+       */
+      guard_t pin() {
+        return (guard_t(*this));
+      }
+
+      /**
+       * @brief Retires the given object, which must already be unreachable
+       * for threads pinning themselves from now on.
+       * @param object the object, destroyed using `delete` once
+       * no thread may still be reading it.
+       */
+      template <typename U>
+      void retire(U* object) {
+        this->retire(object, [] (void* pointer) { delete static_cast<U*>(pointer); });
+      }
+
+      /**
+       * @brief Retires the given object, which must already be unreachable
+       * for threads pinning themselves from now on.
+       * @param object the object to destroy once no thread may still be reading it.
+       * @param destroy the function destroying the object, which may be
+       * called from any thread using the domain.
+       */
+      void retire(void* object, void (*destroy)(void*)) {
+        auto& participant = this->participant();
+
+        participant.limbo.push_back({object, destroy, this->state->epoch.load()});
+        if (++participant.pending == this->batch) {
+          participant.pending = 0;
+          this->collect(participant);
+        }
+      }
+
+      /**
+       * @brief Tries to advance the global epoch, and destroys the
+       * objects retired by the calling thread that became unreachable.
+       * @note Objects retired in an epoch are destroyed once the
+       * global epoch advanced twice.
+       */
+      void collect() {
+        this->collect(this->participant());
+      }
+
+    private:
+
+      // Set in the epoch announced by pinned threads.
+      static constexpr uint64_t ACTIVE = 1;
+
+      /**
+       * @brief An object waiting for the epoch to advance.
+       */
+      struct retired_t {
+        void*    object;
+        void     (*destroy)(void*);
+        uint64_t epoch;
+      };
+
+      /**
+       * @brief The record of a thread using the domain, which is handed
+       * over with its retired objects to another thread when it exits.
+       */
+      struct participant_t {
+        // The epoch the thread is pinned to, shifted left, and `ACTIVE`.
+        std::atomic<uint64_t>  announced{0};
+        std::atomic<bool>      owned{true};
+        size_t                 nesting = 0;
+        size_t                 pending = 0;
+        std::vector<retired_t> limbo;
+        participant_t*         next = nullptr;
+      };
+
+      /**
+       * @brief The state of the domain, which threads exiting after
+       * the domain was destroyed can detect using a weak pointer.
+       */
+      struct state_t {
+        ~state_t() {
+          for (auto participant = this->participants.load(); participant;) {
+            auto next = participant->next;
+            for (auto& retired : participant->limbo) {
+              retired.destroy(retired.object);
+            }
+            delete participant;
+            participant = next;
+          }
+        }
+
+        std::atomic<uint64_t>       epoch{0};
+        std::atomic<participant_t*> participants{nullptr};
+      };
+
+      /**
+       * @brief The participants of the calling thread, released when it exits.
+       */
+      struct registration_t {
+        ~registration_t() {
+          for (auto& [state, participant] : this->participants) {
+            if (auto alive = state.lock()) {
+              participant->owned.store(false, std::memory_order_release);
+            }
+          }
+        }
+
+        std::vector<std::pair<std::weak_ptr<state_t>, participant_t*>> participants;
+      };
+
+      /**
+       * @return the participant of the calling thread, claiming one released
+       * by an exited thread, or registering a new one on first use.
+       */
+      participant_t& participant() {
+        thread_local registration_t registration;
+        auto& participants = registration.participants;
+
+        for (auto it = participants.begin(); it != participants.end();) {
+          if (it->first.expired()) {
+            it = participants.erase(it);
+          } else if (!it->first.owner_before(this->state) && !this->state.owner_before(it->first)) {
+            return (*it->second);
+          } else {
+            ++it;
+          }
+        }
+
+        participant_t* participant = this->state->participants.load(std::memory_order_acquire);
+        for (; participant; participant = participant->next) {
+          bool owned = false;
+          if (participant->owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+            break;
+          }
+        }
+        if (!participant) {
+          participant = new participant_t();
+          participant->next = this->state->participants.load(std::memory_order_relaxed);
+          while (!this->state->participants.compare_exchange_weak(participant->next, participant, std::memory_order_release));
+        }
+        participants.emplace_back(this->state, participant);
+        return (*participant);
+      }
+
+      /**
+       * @brief Advances the global epoch if every pinned thread observed it,
+       * and destroys the objects of the given participant retired two
+       * epochs ago or earlier.
+       */
+      void collect(participant_t& participant) {
+        auto epoch = this->state->epoch.load();
+        auto observed = true;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto other = this->state->participants.load(std::memory_order_acquire); other && observed; other = other->next) {
+          auto announced = other->announced.load(std::memory_order_acquire);
+          observed = !(announced & ACTIVE) || (announced >> 1) == epoch;
+        }
+        if (observed && this->state->epoch.compare_exchange_strong(epoch, epoch + 1)) {
+          epoch++;
+        }
+
+        // Objects are retired in the order of the epochs.
+        auto end = std::find_if(participant.limbo.begin(), participant.limbo.end(), [&] (const retired_t& retired) {
+          return (retired.epoch + 2 > epoch);
+        });
+        std::vector<retired_t> reclaimed(participant.limbo.begin(), end);
+        participant.limbo.erase(participant.limbo.begin(), end);
+        for (auto& retired : reclaimed) {
+          retired.destroy(retired.object);
+        }
+      }
+
+      std::shared_ptr<state_t> state;
+      size_t                   batch;
+  };
+
+  /**
+   * @return the reclamation domain shared by the concurrent trees.
+   */
+  inline epoch_domain_t& default_epoch_domain() {
+    static epoch_domain_t domain;
+    return (domain);
+  }
+
+  /**
+   * @brief Describes the shape of a binary-search tree.
+   */
+  struct tree_stats_t {
+    // The number of nodes in the tree.
+    size_t size;
+    // The number of nodes on the longest path from the root to a leaf.
+    size_t height;
+  };
+
+  /**
+   * @brief Definition of the binary search tree.
+   * @tparam T the type of the values stored in the tree.
+   * @tparam Balance the balancing policy used to restructure
+   * the tree on insertion and removal.
+   * @tparam Options the options used to compare and stringify values.
+   * @tparam Allocator the allocator used to allocate nodes, rebound to `node_type`.
+   * @tparam DefaultIterator the iterator used to traverse the tree.
+   */
+  template <
+    typename T,
+    typename Balance = unbalanced_t,
+    typename Options = default_options_t<T>,
+    typename Allocator = std::allocator<T>,
+    template <typename> class DefaultIterator = dfs_iterator_t
+  >
+  struct tree_t {
+
+    /**
+     * The default iterator has access to the binary-search tree
+     * implementation.
+     */
+    friend DefaultIterator<tree_t>;
+
+    /**
+     * The balancing policy has access to the binary-search tree
+     * implementation to perform rotations.
+     */
+    friend Balance;
+    friend typename balance_of<Balance>::type;
+
+    /**
+     * The type of the values stored in the tree.
+     */
+    using value_type = T;
+
+    /**
+     * The type of the nodes stored in the tree.
+     */
+    using node_type = node_t<T, typename Balance::metadata_t>;
+
+    /**
+     * The allocator types used to allocate nodes.
+     */
+    using allocator_type      = Allocator;
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+
+    /**
+     * Defining the default iterator at the tree level.
+     */
+    using const_iterator = DefaultIterator<tree_t>;
+    using iterator = const_iterator;
+
+    /**
+     * @brief Ensures that the given variadic arguments are
+     * convertible to the given type.
+     */
+    template<typename Type, typename... Ts>
+    using all_of_type = std::enable_if_t<std::conjunction_v<std::is_same<Type, Ts>...>>;
+
+    /**
+     * @brief Ensures that the given type is an iterator, so that
+     * range overloads are not selected for pairs of values.
+     */
+    template<typename Iterator>
+    using if_iterator = typename std::iterator_traits<Iterator>::iterator_category;
+
+    /**
+     * @brief Construct a new binary search tree object.
+     * @param options the options to associate to the tree.
+     */
+    tree_t(): root_{nullptr}, size_of_tree{0}, options{}, allocator{} {}
+
+    /**
+     * @brief Construct a new binary search tree object.
+     * @param options the options to associate to the tree.
+     * @param allocator the allocator used to allocate nodes.
+     */
+    tree_t(const Options& options, const Allocator& allocator = Allocator()):
+      root_{nullptr}, size_of_tree{0}, options{options}, allocator{allocator} {}
+
+    /**
+     * @brief Rejects options of another type than `Options`, such as the
+     * type-erased `options_t<T>` given to a `tree_t<T>`, whose default
+     * options cannot hold a comparator chosen at runtime.
+     */
+    template <typename Comparator, typename Stringifier>
+    tree_t(const options_t<T, Comparator, Stringifier>&, const Allocator& = Allocator()) {
+      static_assert(
+        std::is_same_v<options_t<T, Comparator, Stringifier>, Options>,
+        "the type of the options must be given, e.g tree_t<T, Balance, options_t<T>>(options), or deduced with tree_t(options)"
+      );
+    }
+    
+    /**
+     * Copy-constructor is deleted.
+     */
+    tree_t(const tree_t&) = delete;
+
+    /**
+     * Assignment operator is deleted. 
+     */
+    tree_t& operator=(const tree_t&) = delete;
+
+    /**
+     * @brief Move-constructor, taking over the nodes of `other`
+     * which is left empty.
+     * @param other the tree to move the nodes from.
+     * @note Does not throw unless copying the options does.
+     */
+    tree_t(tree_t&& other) noexcept(std::is_nothrow_copy_constructible_v<Options>):
+      root_{other.root_}, size_of_tree{other.size_of_tree}, options{other.options}, balance{other.balance}, allocator{other.allocator} {
+      other.root_ = nullptr;
+      other.size_of_tree = 0;
+    }
+
+    /**
+     * @brief Move-assignment operator, clearing the tree and taking
+     * over the nodes of `other` which is left empty.
+     * @param other the tree to move the nodes from.
+     * @return a reference to the tree.
+     * @note Does not throw unless copying the options does.
+     */
+    tree_t& operator=(tree_t&& other) noexcept(std::is_nothrow_copy_assignable_v<Options>) {
+      if (this != &other) {
+        this->clear();
+        this->root_        = other.root_;
+        this->size_of_tree = other.size_of_tree;
+        this->options      = other.options;
+        this->balance      = other.balance;
+        this->allocator    = other.allocator;
+        other.root_        = nullptr;
+        other.size_of_tree = 0;
+      }
+      return (*this);
+    }
+
+    /**
+     * @brief Binary-search tree destructor.
+     */
+    ~tree_t() {
+      this->clear();
+    }
+
+    /**
+     * @brief Inserts a set of values provided by the iterator
+     * in the binary-search tree.
+     * @param begin the iterator to the beginning of the iterable.
+     * @param end the iterator to the end of the iterable.
+     */
+    template<typename Iterator, typename = if_iterator<Iterator>>
+    void insert(Iterator begin, Iterator end) {
+      for (Iterator it = begin; it != end; ++it) {
+        this->insert(*it);
+      }
+    }
+
+    /**
+     * @brief Inserts a set of values provided as variadic arguments
+     * in the binary search tree.
+     * @param args the values to insert in the tree.
+     */
+    template <class... Args>
+    void insert(Args... args) {
+      auto callable = [&] (T&& arg) { this->insert(std::move(arg)); };
+      (callable(std::move(args)),...);
+    }
+
+    /**
+     * @brief Inserts the given `data` in the binary-search tree.
+     * @param data a reference to the data to insert in the binary-search tree.
+     * @return a pointer to the created node that wraps the given data.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* insert(const T& data) {
+      return (this->try_emplace(data, data));
+    }
+
+    /**
+     * @brief Moves the given `data` into the binary-search tree.
+     * @param data the data to move into the binary-search tree.
+     * @return a pointer to the created node that wraps the given data,
+     * or NULL if the data already exists, in which case it is not moved.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* insert(T&& data) {
+      return (this->try_emplace(data, std::move(data)));
+    }
+
+    /**
+     * @brief Constructs a value in place in a new node, and inserts
+     * the node in the binary-search tree.
+     * @param args the arguments forwarded to the constructor of the value.
+     * @return a pointer to the created node, or NULL if an equal value
+     * already exists, in which case the constructed value is destroyed.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    template <typename... Args>
+    const node_type* emplace(Args&&... args) {
+      auto new_node = this->create_node(std::forward<Args>(args)...);
+      auto [parent, result] = this->locate(new_node->value());
+
+      if (parent && !result) {
+        this->destroy_node(new_node);
+        this->balance.on_access(*this, parent);
+        return (nullptr);
+      }
+      return (this->attach(parent, new_node, result < 0 ? LEFT : RIGHT));
+    }
+
+    /**
+     * @brief Constructs a value in place in a new node only if no value
+     * equal to the given `key` exists in the binary-search tree.
+     * @param key the key to look up, which must compare equal to
+     * the value constructed from `args`.
+     * @param args the arguments forwarded to the constructor of the value.
+     * @return a pointer to the created node, or NULL if the key already
+     * exists, in which case no value is constructed.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    template <typename Key, typename... Args>
+    const node_type* try_emplace(const Key& key, Args&&... args) {
+      auto [parent, result] = this->locate(key);
+
+      if (parent && !result) {
+        this->balance.on_access(*this, parent);
+        return (nullptr);
+      }
+      return (this->attach(parent, this->create_node(std::forward<Args>(args)...), result < 0 ? LEFT : RIGHT));
+    }
+
+    /**
+     * @brief Replaces the content of the binary-search tree with the
+     * given sorted values, building a tree of minimal height.
+     * @param begin the iterator to the beginning of the sorted values.
+     * @param end the iterator to the end of the sorted values.
+     * @throws std::invalid_argument if the values are not sorted, in
+     * which case the tree is left untouched.
+     * @note Equal values are only inserted once. The new nodes are built
+     * before the previous ones are destroyed, so that the tree is left
+     * untouched if an exception is thrown. Nodes are allocated in order,
+     * so that pool and arena allocators lay them out contiguously, and
+     * with allocators releasable at once, such as `arena_allocator_t`,
+     * from a new arena which replaces the allocator of the tree.
+     * Complexity is O(n).
+     */
+    template<typename Iterator, typename = if_iterator<Iterator>>
+    void build_from_sorted(Iterator begin, Iterator end) {
+      constexpr bool releasable = is_releasable<node_allocator_type>::value;
+      std::vector<node_type*> nodes;
+
+      auto allocator = this->fresh_allocator();
+      try {
+        for (Iterator it = begin; it != end; ++it) {
+          if (!nodes.empty()) {
+            int result = this->options.compare(*it, nodes.back()->value());
+
+            if (result < 0) {
+              throw std::invalid_argument("Values are not sorted");
+            } else if (result == 0) {
+              // Equal values are only inserted once.
+              continue;
+            }
+          }
+
+          // Reserving the slot of the node first, so that
+          // it cannot leak if the vector fails to grow.
+          nodes.push_back(nullptr);
+          auto node = allocator_traits::allocate(allocator, 1);
+          try {
+            allocator_traits::construct(allocator, node, std::in_place, *it);
+          } catch (...) {
+            allocator_traits::deallocate(allocator, node, 1);
+            throw;
+          }
+          nodes.back() = node;
+        }
+      } catch (...) {
+        for (auto node : nodes) {
+          if (node) {
+            allocator_traits::destroy(allocator, node);
+            allocator_traits::deallocate(allocator, node, 1);
+          }
+        }
+        throw;
+      }
+
+      this->clear();
+      if constexpr (releasable) {
+        this->allocator = allocator;
+      }
+      this->size_of_tree = nodes.size();
+      this->root_ = this->link(nodes, 0, nodes.size(), nullptr, 0, max_depth_of(nodes.size()));
+    }
+
+    /**
+     * @brief Inserts a set of unsorted values provided by the iterator in the
+     * binary-search tree using the given thread pool. A node is created for
+     * every value, the nodes are sorted and deduplicated in parallel, linked
+     * into a balanced subtree whose halves are linked in parallel, which is
+     * then united with the tree.
+     * @param begin the iterator to the beginning of the values.
+     * @param end the iterator to the end of the values.
+     * @param pool the thread pool sorting and linking the nodes.
+     * @note Values equal to values of the tree are not inserted. Nodes are
+     * created in parallel from random-access iterators when using
+     * `std::allocator`, and sequentially otherwise. Values must be compared
+     * without throwing exceptions. Complexity is O(nlog(n)) work, with a
+     * span of O(n) bound by the final merge of the sort.
+     */
+    template<typename Iterator, typename = if_iterator<Iterator>>
+    void bulk_insert(Iterator begin, Iterator end, thread_pool_t& pool = default_thread_pool()) {
+      using category = typename std::iterator_traits<Iterator>::iterator_category;
+      std::vector<node_type*> nodes;
+      auto forks = forks_of(pool);
+
+      // Creating a node for every value.
+      try {
+        if constexpr (std::is_same_v<node_allocator_type, std::allocator<node_type>> && std::is_base_of_v<std::random_access_iterator_tag, category>) {
+          nodes.resize(end - begin, nullptr);
+          parallel_for(0, nodes.size(), forks, pool, [&] (size_t i) {
+            nodes[i] = this->create_node(begin[i]);
+          });
+        } else {
+          for (Iterator it = begin; it != end; ++it) {
+            nodes.push_back(this->create_node(*it));
+          }
+        }
+      } catch (...) {
+        for (auto node : nodes) {
+          if (node) {
+            this->destroy_node(node);
+          }
+        }
+        throw;
+      }
+
+      // Sorting the nodes, and destroying the duplicates.
+      parallel_sort(nodes.begin(), nodes.end(), [this] (const node_type* lhs, const node_type* rhs) {
+        return (this->options.compare(lhs->value(), rhs->value()) < 0);
+      }, forks, pool);
+      size_t count = 0;
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        if (count && this->options.compare(nodes[count - 1]->value(), nodes[i]->value()) == 0) {
+          this->destroy_node(nodes[i]);
+        } else {
+          nodes[count++] = nodes[i];
+        }
+      }
+      nodes.resize(count);
+
+      // Linking the subtree, and uniting it with the tree.
+      auto other = tree_t(this->options, this->allocator, std::in_place);
+      other.size_of_tree = nodes.size();
+      other.root_ = other.link(nodes, 0, nodes.size(), nullptr, 0, max_depth_of(nodes.size()), forks, pool);
+      this->absorb(std::move(other), pool);
+    }
+
+    /**
+     * @brief Removes a set of values provided by the iterator
+     * from the binary-search tree.
+     * @param begin the iterator to the beginning of the iterable.
+     * @param end the iterator to the end of the iterable.
+     */
+    template<typename Iterator, typename = if_iterator<Iterator>>
+    void remove(Iterator begin, Iterator end) {
+      // The iterator is advanced before the removal, so that
+      // the tree can be cleared using its own iterators.
+      for (Iterator it = begin; it != end;) {
+        const T value = *it++;
+        this->remove(value);
+      }
+    }
+
+    /**
+     * @brief Removes a set of values provided as variadic arguments
+     * from the binary search tree.
+     * @param args the values to remove from the tree.
+     * @note Complexity is O(nlog(n)) on average, O(n2) on the worst case.
+     */
+    template <class... Args>
+    void remove(Args... args) {
+      auto callable = [&] (const T& arg) { this->remove(arg); };
+      (callable(std::forward<Args>(args)),...);
+    }
+
+    /**
+     * @brief Removes the node associated with the given `data` from the binary-search tree
+     * starting from the given subtree.
+     * @param node the subtree to walk the tree from. 
+     * @param data the data to remove from the binary-search tree.
+     * @return a pointer to the successor node, or a NULL value
+     * if there is no successor.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    node_type* remove(node_type* node, const T& data) {
+      // Looking up the node associated with the data.
+      while (node) {
+        int result = this->options.compare(data, node->value());
+
+        if (result < 0)
+          node = node->left;
+        else if (result > 0)
+          node = node->right;
+        else
+          return (this->erase(node));
+      }
+      return (nullptr);
+    }
+
+    /**
+     * @brief Removes the node associated with the given `data` from the binary-search tree.
+     * @param data the data to remove from the binary-search tree.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    void remove(const T& data) {
+      remove(this->root_, data);
+    }
+
+    /**
+     * @brief Removes the node associated with the given `data` from the
+     * binary-search tree, deferring its destruction until no thread pinned
+     * in the given domain may still be reading it.
+     * @param data the data to remove from the binary-search tree.
+     * @param domain the domain reclaiming the node.
+     * @note Writers must still be serialized with readers walking the tree,
+     * but nodes and values obtained by pinned threads remain valid.
+     * Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    void remove(const T& data, epoch_domain_t& domain) {
+      if (auto node = std::as_const(*this).find(data)) {
+        auto unlinked = const_cast<node_type*>(*node);
+        this->unlink(unlinked);
+        this->retire(unlinked, domain);
+      }
+    }
+    
+    /**
+     * @brief Clears the given subtree.
+     * @param node the root of the subtree to clear.
+     * @note Complexity is O(n) on average, and the subtree is walked
+     * using parent links so that no stack space is consumed.
+     */
+    void clear(node_type* node) {
+      auto current = node;
+
+      if constexpr (is_order_statistic) {
+        // The ancestors of the subtree lose all of its nodes.
+        for (auto ancestor = node ? node->parent : nullptr; ancestor; ancestor = ancestor->parent) {
+          ancestor->size -= node->size;
+        }
+      }
+
+      while (current) {
+        // Descending to a leaf of the subtree.
+        if (current->left) {
+          current = current->left;
+          continue;
+        }
+        if (current->right) {
+          current = current->right;
+          continue;
+        }
+
+        auto parent = current->parent;
+
+        // Detaching the node from its parent.
+        if (parent && parent->left == current)
+          parent->left = nullptr;
+        if (parent && parent->right == current)
+          parent->right = nullptr;
+
+        // Decremeneting the size of the tree.
+        this->size_of_tree--;
+
+        // If the node is the root, we need to assign
+        // the root to a null pointer type.
+        if (this->root_ == current) {
+          this->root_ = nullptr;
+        }
+        this->destroy_node(current);
+
+        // Walking back up until the root of the subtree is destroyed.
+        current = current == node ? nullptr : parent;
+      }
+    }
+    
+    /**
+     * @brief Clears the binary-search tree.
+     * @return the number of nodes removed from the tree.
+     * @note Complexity is O(n) on average. When nodes are trivially destructible
+     * and allocated from an arena, the arena is released without visiting the nodes.
+     */
+    void clear() {
+      if constexpr (is_releasable<node_allocator_type>::value && std::is_trivially_destructible_v<node_type>) {
+        // An empty tree may share its arena, e.g the scratch tree of a bulk insertion.
+        if (this->root_) {
+          this->allocator.release();
+        }
+        this->root_ = nullptr;
+      } else {
+        this->clear(this->root_);
+      }
+      this->size_of_tree = 0;
+    }
+
+    /**
+     * @brief Clears the binary-search tree, deferring the destruction
+     * of its nodes until no thread pinned in the given domain may
+     * still be reading them.
+     * @param domain the domain reclaiming the nodes.
+     * @note Complexity is O(n).
+     */
+    void clear(epoch_domain_t& domain) {
+      auto root = this->root_;
+
+      this->root_ = nullptr;
+      this->size_of_tree = 0;
+      post_order(root, [&] (node_type* node, size_t) {
+        this->retire(node, domain);
+      });
+    }
+
+    /**
+     * @brief Looks-up the binary-search tree for the nodes
+     * associated with the given iterator.
+     * @param begin the iterator to the beginning of the iterable.
+     * @param end the iterator to the end of the iterable.
+     * @return a vector of optional pointers to the found nodes.
+     */
+    template<typename Iterator, typename = if_iterator<Iterator>>
+    auto find(Iterator begin, Iterator end) {
+      using category = typename std::iterator_traits<Iterator>::iterator_category;
+      std::vector<std::optional<const node_type*>> nodes;
+
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+        nodes.reserve(std::distance(begin, end));
+      }
+      this->find(begin, end, std::back_inserter(nodes));
+      return (nodes);
+    }
+
+    /**
+     * @brief Looks-up the binary-search tree for the nodes associated
+     * with the given iterator, writing the results to `out`. Keys are
+     * looked up in groups whose descents are interleaved one level at
+     * a time, the next node of every key being prefetched while the other
+     * keys of the group advance, so that their cache misses overlap.
+     * @param begin the iterator to the beginning of the iterable.
+     * @param end the iterator to the end of the iterable.
+     * @param out the output iterator receiving an optional pointer
+     * to the found node of every key, in order.
+     * @return the output iterator past the last written result.
+     * @note Complexity is O(k.log(n)) on average, O(k.n) in the worst case.
+     * The balancing policy is given each last visited node once the whole
+     * group has been looked up, in the order of the keys.
+     */
+    template<typename Iterator, typename OutputIterator, typename = if_iterator<Iterator>>
+    OutputIterator find(Iterator begin, Iterator end, OutputIterator out) {
+      constexpr size_t group = 16;
+      using traits = std::iterator_traits<Iterator>;
+      // References yielded by input iterators may not outlive an increment.
+      constexpr bool addressable = std::is_lvalue_reference_v<typename traits::reference>
+        && std::is_base_of_v<std::forward_iterator_tag, typename traits::iterator_category>;
+      std::array<const T*, group> keys;
+      std::array<const node_type*, group> nodes;
+      std::array<const node_type*, group> visited;
+      std::array<bool, group> found;
+      std::vector<T> copies;
+
+      if constexpr (!addressable) {
+        copies.reserve(group);
+      }
+      while (begin != end) {
+        size_t count = 0;
+
+        // Gathering the keys of the group, copying them when the
+        // iterator does not yield stable references.
+        copies.clear();
+        for (; begin != end && count < group; ++begin, ++count) {
+          if constexpr (addressable) {
+            keys[count] = std::addressof(*begin);
+          } else {
+            keys[count] = std::addressof(copies.emplace_back(*begin));
+          }
+        }
+        nodes.fill(this->root_);
+        visited.fill(nullptr);
+        found.fill(false);
+
+        // Advancing every pending descent by one level per round.
+        for (size_t pending = this->root_ ? count : 0; pending > 0;) {
+          for (size_t i = 0; i < count; ++i) {
+            auto node = nodes[i];
+
+            if (!node) {
+              continue;
+            }
+            auto result = this->options.compare(*keys[i], node->value());
+
+            visited[i] = node;
+            if (result == 0) {
+              found[i] = true;
+              node = nullptr;
+            } else {
+              node = result < 0 ? node->left : node->right;
+            }
+            if (node) {
+              prefetch(node);
+            } else {
+              --pending;
+            }
+            nodes[i] = node;
+          }
+        }
+
+        // Writing the results, in order.
+        for (size_t i = 0; i < count; ++i) {
+          if (visited[i]) {
+            this->balance.on_access(*this, visited[i]);
+          }
+          if (found[i]) {
+            *out++ = std::optional<const node_type*>(visited[i]);
+          } else {
+            *out++ = std::optional<const node_type*>();
+          }
+        }
+      }
+      return (out);
+    }
+
+    /**
+     * @brief Looks-up the binary-search tree for the nodes
+     * associated with the given variadic arguments.
+     * @param args the values to search for in the tree.
+     * @return an array of optional pointers to the found nodes.
+     */
+    template <class... Args, typename = typename std::enable_if<all_of_type<T, Args...>::value>::type>
+    auto find(Args const& ... args) {
+      size_t idx = 0;
+      std::array<
+        std::optional<const node_type*>, sizeof...(Args)
+      > nodes = {};
+
+      // The callable function inserts the results
+      // of the find operation into the array.
+      auto callable = [&] (const T& arg) {
+        nodes[idx++] = this->find(arg);
+      };
+
+      (callable(std::forward<Args>(args)),...);
+      return (nodes);
+    }
+
+    /**
+     * @brief Traverse the subtree to find
+     * the node associated with the given `data`.
+     * @param node the node to start the traversal from.
+     * @param data the data to find in the given subtree.
+     * @return an optional pointer to the found node.
+     * @note Complexity is O(log(n)) on average, O(n) in the worst case.
+     */
+    std::optional<const node_type*> find(const node_type* node, const T& data) const {
+      while (node) {
+        /* Comparing the value associated with the nodes. */
+        auto result = this->options.compare(data, node->value());
+
+        if (result < 0) {
+          node = node->left;
+        } else if (result > 0) {
+          node = node->right;
+        } else {
+          return (node);
+        }
+      }
+      return {};
+    }
+
+    /**
+     * @brief A method finding the node associated with `data`
+     * in the binary-search tree.
+     * @param data a reference to the data to look up.
+     * @return a pointer to the node containing the data, or NULL if the node
+     * was not found.
+     * @note Complexity is O(log(n)) on average, O(n) in the worst case.
+     */
+    std::optional<const node_type*> find(const T& data) const {
+      return (this->find(this->root_, data));
+    }
+
+    /**
+     * @brief A method finding the node associated with `data` in the
+     * binary-search tree, letting the balancing policy restructure the
+     * tree around the last visited node, e.g to move it to the root.
+     * @param data a reference to the data to look up.
+     * @return a pointer to the node containing the data, or NULL if the node
+     * was not found.
+     * @note Complexity is O(log(n)) on average, O(n) in the worst case,
+     * or O(log(n)) amortized in splay trees.
+     */
+    std::optional<const node_type*> find(const T& data) {
+      auto [node, result] = this->locate(data);
+
+      if (node) {
+        this->balance.on_access(*this, node);
+      }
+      if (!node || result) {
+        return {};
+      }
+      return (node);
+    }
+
+    /**
+     * @brief Recursively traverse the given subtree to find
+     * the node associated with the smallest value.
+     * @param node the node to start the traversal from.
+     * @return a pointer to the node associated with the smallest value.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* min(const node_type* node) const {
+      while (node && node->left != nullptr)
+        node = node->left;
+      return (node);
+    } 
+
+    /**
+     * @brief Recursively traverse the binary-search tree to find
+     * the node associated with the smallest value.
+     * @return a pointer to the node associated with the smallest value.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* min() const {
+      return (this->min(this->root_));
+    }
+
+    /**
+     * @brief Recursively traverse the given subtree to find
+     * the node associated with the biggest value.
+     * @param node the node to start the traversal from.
+     * @return a pointer to the node associated with the biggest value.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* max(const node_type* node) const {
+      while (node && node->right != nullptr)
+        node = node->right;
+      return (node);
+    }
+    
+    /**
+     * @brief Recursively traverse the binary-search tree to find
+     * the node associated with the biggest value.
+     * @return a pointer to the node associated with the biggest value.
+     * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* max() const {
+      return (this->max(this->root_));
+    }
+
+    /**
+     * @return the number of nodes contained by the
+     * binary search tree.
+     */
+    size_t size() const {
+      return (this->size_of_tree);
+    }
+
+    /**
+     * @brief Rebalances the binary-search tree in place using the
+     * Day-Stout-Warren algorithm, which first turns the tree into a
+     * sorted list of right children, then folds the list into a
+     * complete tree through left rotations.
+     * @note Restores a minimal height to trees which drifted after
+     * insertions and removals, and resets the metadata of the
+     * balancing policy. Complexity is O(n) with O(1) extra space.
+     */
+    void rebalance() {
+      if (this->root_) {
+        this->rebuild(this->root_, this->size());
+      }
+
+      // Resetting the balancing metadata of every node.
+      auto max_depth = max_depth_of(this->size());
+      post_order(this->root_, [&] (node_type* node, size_t depth) {
+        this->update_size(node);
+        this->balance.on_build(*this, node, depth, max_depth);
+      });
+    }
+
+    /**
+     * @brief Reallocates the nodes of the binary-search tree in van Emde Boas
+     * order, i.e laying out the top half of the levels of the tree, then every
+     * subtree rooted below them, recursively, so that a descent touches
+     * O(log_B(n)) blocks of memory whatever the size B of cache lines and
+     * pages. Useful on long-lived trees whose nodes were scattered in memory
+     * by insertions and removals.
+     * @note The shape of the tree and the metadata of the balancing policy are
+     * left untouched, but pointers to the nodes and iterators are invalidated.
+     * With allocators releasable at once, such as `arena_allocator_t`, the
+     * nodes are allocated as a single contiguous block from a new arena, i.e a
+     * default-constructed allocator which replaces the allocator of the tree
+     * once the previous arena is released, so that relayouts do not grow the
+     * memory of the tree. The tree then no longer shares its allocator with
+     * the trees it was joined with. Other allocators allocate the nodes one
+     * after another and deallocate the previous nodes one by one, the nodes
+     * being contiguous only if consecutive allocations are served from
+     * consecutive addresses, e.g by a `pool_allocator_t` without any released
+     * slot to reuse. Values are moved if they can be without throwing, copied
+     * otherwise, and the tree is left untouched if an exception is thrown.
+     * Complexity is O(n.log(n)).
+     */
+    void relayout() {
+      constexpr bool releasable = is_releasable<node_allocator_type>::value;
+      std::vector<node_type*> order;
+      std::vector<node_type*> nodes;
+      std::vector<std::pair<const node_type*, node_type*>> mapping;
+      size_t constructed = 0;
+
+      if (!this->root_) {
+        return;
+      }
+      order.reserve(this->size());
+      van_emde_boas(this->root_, this->stats().height, order);
+      nodes.reserve(order.size());
+      mapping.reserve(order.size());
+
+      // Allocating every node before constructing any of them,
+      // so that no value is moved if an allocation fails.
+      auto allocator = this->fresh_allocator();
+      try {
+        if constexpr (releasable) {
+          auto block = allocator_traits::allocate(allocator, order.size());
+          for (size_t i = 0; i < order.size(); ++i) {
+            nodes.push_back(block + i);
+          }
+        } else {
+          for (size_t i = 0; i < order.size(); ++i) {
+            nodes.push_back(allocator_traits::allocate(allocator, 1));
+          }
+        }
+        for (; constructed < order.size(); ++constructed) {
+          allocator_traits::construct(allocator, nodes[constructed], std::in_place, std::move_if_noexcept(order[constructed]->data));
+        }
+      } catch (...) {
+        for (size_t i = 0; i < constructed; ++i) {
+          allocator_traits::destroy(allocator, nodes[i]);
+        }
+        // A new arena is released along with its block.
+        if constexpr (!releasable) {
+          for (auto node : nodes) {
+            allocator_traits::deallocate(allocator, node, 1);
+          }
+        }
+        throw;
+      }
+
+      // Mapping the previous nodes to the new ones, sorted by address.
+      for (size_t i = 0; i < order.size(); ++i) {
+        mapping.emplace_back(order[i], nodes[i]);
+      }
+      std::sort(mapping.begin(), mapping.end(), [] (const auto& lhs, const auto& rhs) {
+        return (std::less<const node_type*>()(lhs.first, rhs.first));
+      });
+      auto forward = [&] (const node_type* node) -> node_type* {
+        if (!node) {
+          return (nullptr);
+        }
+        auto it = std::lower_bound(mapping.begin(), mapping.end(), node, [] (const auto& entry, const node_type* node) {
+          return (std::less<const node_type*>()(entry.first, node));
+        });
+        return (it->second);
+      };
+
+      // Copying the links and the metadata of the previous nodes.
+      for (size_t i = 0; i < order.size(); ++i) {
+        static_cast<typename Balance::metadata_t&>(*nodes[i]) = static_cast<const typename Balance::metadata_t&>(*order[i]);
+        nodes[i]->left   = forward(order[i]->left);
+        nodes[i]->right  = forward(order[i]->right);
+        nodes[i]->parent = forward(order[i]->parent);
+      }
+      this->root_ = nodes.front();
+      for (auto node : order) {
+        this->destroy_node(node);
+      }
+      if constexpr (releasable) {
+        this->allocator.release();
+        this->allocator = allocator;
+      }
+    }
+
+    /**
+     * @return the size and the height of the binary-search tree.
+     * @note Complexity is O(n) with O(1) extra space.
+     */
+    tree_stats_t stats() const {
+      size_t height = 0;
+
+      post_order(this->root_, [&] (const node_type*, size_t depth) {
+        height = std::max(height, depth + 1);
+      });
+      return {this->size(), height};
+    }
+
+    /**
+     * @return an immutable copy of the values of the tree, laid out
+     * in a single array searched without chasing pointers.
+     * @note Complexity is O(n). The copy is left untouched by
+     * later mutations of the tree.
+     */
+    frozen_tree_t<T, Options> freeze() const {
+      return (frozen_tree_t<T, Options>(this->begin(), this->end(), this->options));
+    }
+
+    /**
+     * @brief Looks up the value of the given rank, i.e the `k`-th
+     * smallest value of the tree, starting from 0.
+     * @param k the rank of the value to look up.
+     * @return a pointer to the node associated with the value,
+     * or NULL if `k` is not less than the size of the tree.
+     * @note Requires an `order_statistic_t` balancing policy.
+     * Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    const node_type* select(size_t k) const {
+      static_assert(is_order_statistic, "select requires an order_statistic_t balancing policy");
+      const node_type* node = this->root_;
+
+      while (node) {
+        auto left = subtree_size(node->left);
+
+        if (k < left) {
+          node = node->left;
+        } else if (k > left) {
+          k -= left + 1;
+          node = node->right;
+        } else {
+          return (node);
+        }
+      }
+      return (nullptr);
+    }
+
+    /**
+     * @brief Computes the rank of the given key, which is the number
+     * of values of the tree strictly less than the key.
+     * @param key the key to rank, which does not need to be in the tree.
+     * @return the number of values less than `key`.
+     * @note Requires an `order_statistic_t` balancing policy.
+     * Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    template <typename Key>
+    size_t rank(const Key& key) const {
+      static_assert(is_order_statistic, "rank requires an order_statistic_t balancing policy");
+      return (this->count_below(key, false));
+    }
+
+    /**
+     * @brief Counts the values of the tree within the given bounds.
+     * @param lo the inclusive lower bound.
+     * @param hi the inclusive upper bound.
+     * @return the number of values in `[lo, hi]`.
+     * @note Requires an `order_statistic_t` balancing policy.
+     * Complexity is O(log(n)) on average, O(n) on the worst case.
+     */
+    template <typename Key>
+    size_t count_range(const Key& lo, const Key& hi) const {
+      static_assert(is_order_statistic, "count_range requires an order_statistic_t balancing policy");
+      auto upper = this->count_below(hi, true);
+      auto lower = this->count_below(lo, false);
+      return (upper > lower ? upper - lower : 0);
+    }
+
+    /**
+     * @brief Splits the binary-search tree into a tree holding the values
+     * less than `key`, and a tree holding the other values. Nodes are
+     * re-parented without being reallocated, and this tree is left empty.
+     * @param key the key to split the tree around.
+     * @return the lower and the upper trees.
+     * @note The subtrees hanging off the search path of `key` are joined
+     * bottom-up, which is O(log(n)) in red-black and AVL trees. The size
+     * of the lower tree is then counted in O(n), or read from its root
+     * in O(1) in order-statistic trees, which makes the whole split
+     * O(log(n)) only in order-statistic trees. Trees allocating their
+     * nodes from an arena cannot be split, since both parts would share it.
+     */
+    template <typename Key>
+    std::pair<tree_t, tree_t> split(const Key& key) {
+      static_assert(!is_releasable<node_allocator_type>::value, "split requires trees not to share their arena");
+      auto lower = tree_t(this->options, this->allocator);
+      auto upper = tree_t(this->options, this->allocator);
+      auto size  = this->size_of_tree;
+      auto [lower_root, equal, upper_root] = this->divide(this->root_, key);
+
+      // The node equal to the key goes to the upper tree.
+      if (equal) {
+        this->join(nullptr, equal, upper_root);
+        upper_root = this->root_;
+      }
+
+      this->root_ = nullptr;
+      this->size_of_tree = 0;
+      lower.size_of_tree = count_nodes(lower_root);
+      lower.adopt(lower_root);
+      upper.size_of_tree = size - lower.size_of_tree;
+      upper.adopt(upper_root);
+      return {std::move(lower), std::move(upper)};
+    }
+
+    /**
+     * @brief Moves the values of `other`, which must all be greater than
+     * the values of this tree, into this tree. The smallest node of `other`
+     * is unlinked and joins both trees, without reallocating any node.
+     * @param other the tree to move the values from, which is left empty.
+     * @throws std::invalid_argument if the trees do not share the same
+     * allocator, or if their values overlap, in which case both trees
+     * are left untouched.
+     * @note Complexity is O(log(n)) in red-black and AVL trees,
+     * O(1) when one of the trees is empty. Trees allocating their nodes
+     * from an arena cannot be joined, since both trees would share it.
+     */
+    void join(tree_t&& other) {
+      static_assert(!is_releasable<node_allocator_type>::value, "join requires trees not to share their arena");
+      if (this->allocator != other.allocator) {
+        throw std::invalid_argument("Trees do not share the same allocator");
+      }
+      if (!other.root_) {
+        return;
+      }
+      if (!this->root_) {
+        std::swap(this->root_, other.root_);
+        std::swap(this->size_of_tree, other.size_of_tree);
+        std::swap(this->balance, other.balance);
+        return;
+      }
+      if (this->options.compare(this->max()->value(), other.min()->value()) >= 0) {
+        throw std::invalid_argument("Trees are not key-disjoint");
+      }
+
+      auto middle = const_cast<node_type*>(other.min());
+      other.unlink(middle);
+      auto size   = this->size_of_tree + other.size_of_tree + 1;
+      auto right  = other.root_;
+
+      other.root_ = nullptr;
+      other.size_of_tree = 0;
+      this->join(this->root_, middle, right);
+      this->size_of_tree = size;
+    }
+
+    /**
+     * @brief Moves the values of `other` into the binary-search tree using
+     * the join-based divide-and-conquer union. The tree is split around the
+     * root of `other`, both halves are united with the subtrees of `other`
+     * in parallel, and the results are joined back with the root.
+     * @param other the tree to move the values from, which is left empty.
+     * Nodes of `other` holding values of the tree are destroyed.
+     * @param pool the thread pool running the halves in parallel.
+     * @throws std::invalid_argument if the trees do not share the same
+     * allocator, in which case both trees are left untouched.
+     * @note Nodes are re-parented without being reallocated. Values must be
+     * compared without throwing exceptions. Complexity is O(mlog(n/m + 1))
+     * in red-black and AVL trees of sizes m <= n, with a recursion depth
+     * of the height of `other`. Trees allocating their nodes from an arena
+     * cannot be united, since both trees would share it.
+     */
+    void union_with(tree_t&& other, thread_pool_t& pool = default_thread_pool()) {
+      static_assert(!is_releasable<node_allocator_type>::value, "union_with requires trees not to share their arena");
+      if (&other == this) {
+        return;
+      }
+      if (this->allocator != other.allocator) {
+        throw std::invalid_argument("Trees do not share the same allocator");
+      }
+      this->absorb(std::move(other), pool);
+    }
+
+    /**
+     * @brief Removes the values of the binary-search tree which are not in
+     * `other` using the join-based divide-and-conquer intersection. The tree
+     * is split around the root of `other`, both halves are intersected with
+     * the subtrees of `other` in parallel, and the results are joined back.
+     * @param other the tree to intersect the tree with, which is left untouched.
+     * @param pool the thread pool running the halves in parallel.
+     * @note Values must be compared without throwing exceptions. Complexity
+     * is O(mlog(n/m + 1)) in red-black and AVL trees of sizes m <= n, along
+     * with the destruction of the removed nodes.
+     */
+    void intersect_with(const tree_t& other, thread_pool_t& pool = default_thread_pool()) {
+      if (&other == this) {
+        return;
+      }
+
+      auto scratch = this->scratch();
+      std::vector<node_type*> garbage;
+      auto root = scratch.intersect(this->root_, other.root_, forks_of(pool), pool, garbage);
+
+      scratch.root_ = nullptr;
+      this->settle(root, garbage);
+    }
+
+    /**
+     * @brief Removes the values of `other` from the binary-search tree using
+     * the join-based divide-and-conquer difference. The tree is split around
+     * the root of `other`, the subtrees of `other` are removed from both
+     * halves in parallel, and the results are joined back.
+     * @param other the tree holding the values to remove, which is left untouched.
+     * @param pool the thread pool running the halves in parallel.
+     * @note Values must be compared without throwing exceptions. Complexity
+     * is O(mlog(n/m + 1)) in red-black and AVL trees of sizes m <= n, along
+     * with the destruction of the removed nodes.
+     */
+    void difference_with(const tree_t& other, thread_pool_t& pool = default_thread_pool()) {
+      if (&other == this) {
+        this->clear();
+        return;
+      }
+
+      auto scratch = this->scratch();
+      std::vector<node_type*> garbage;
+      auto root = scratch.subtract(this->root_, other.root_, forks_of(pool), pool, garbage);
+
+      scratch.root_ = nullptr;
+      this->settle(root, garbage);
+    }
+
+    /**
+     * @return a pointer to the root node of the tree.
+     */
+    const node_type* root() const {
+      return (this->root_);
+    }
+
+    /**
+     * @return a string representation of the binary-search tree.
+     * @param node the node to start the traversal from.
+     * @param result the string to append the result to.
+     * @param prefix the prefix to use for each line.
+     * @note Complexity is O(n) on average, O(n) on the worst case.
+     */
+    const std::string to_string(const node_type* node, std::string result = "", std::string prefix = "") const {
+      // The nodes left to display, along with their prefix.
+      std::vector<std::pair<const node_type*, std::string>> stack;
+
+      stack.emplace_back(node, std::move(prefix));
+      while (!stack.empty()) {
+        auto [current, current_prefix] = std::move(stack.back());
+        stack.pop_back();
+        if (!current) {
+          // We reached the end of a subtree.
+          continue;
+        }
+        // Concatenate the prefix with the current node's data.
+        result += current_prefix + "├──" + this->options.to_string(current->value()) + "\n";
+        // Whether the current node is the left child of its parent.
+        bool isRight = current->parent && current->parent->right == current;
+        // A separator to display between the current node's children.
+        std::string separator = isRight ? "│  " : "   ";
+        // Display the right children first, then the left children.
+        stack.emplace_back(current->left, current_prefix + separator);
+        stack.emplace_back(current->right, current_prefix + separator);
+      }
+      return (result);
+    }
+    
+    /**
+     * @return a string representation of the binary-search tree.
+     */
+    const std::string to_string() const {
+      return (this->to_string(this->root_));
+    }
+
+    /**
+     * @brief Outputs a string representation of the binary-search tree
+     * to the given stream.
+     * @param stream the stream to output the string representation to.
+     * @param tree the binary-search tree to output.
+     * @return a reference to the stream.
+     */
+    friend std::ostream& operator<<(std::ostream& stream, const tree_t& tree) {
+      stream << tree.to_string();
+      return (stream);
+    }
+    
+    /**
+     * @return an iterator to the first node in the binary-search tree.
+     * @note Uses the depth-first search iterator by default.
+     */
+    const_iterator begin() const {
+      return (const_iterator(this->min(), this));
+    }
+
+    /**
+     * @return an iterator to the last node in the binary-search tree.
+     * @note Uses the depth-first search iterator by default.
+     */
+    const_iterator end() const {
+      return (const_iterator(nullptr, this));
+    }
+
+    private:
+      node_type* root_;
+      size_t size_of_tree;
+      Options options;
+      Balance balance;
+      node_allocator_type allocator;
+
+      /**
+       * The traits of the node allocator.
+       */
+      using allocator_traits = std::allocator_traits<node_allocator_type>;
+
+      /**
+       * Whether nodes store the size of their subtree.
+       */
+      static constexpr bool is_order_statistic = has_subtree_size<typename Balance::metadata_t>::value;
+
+      /**
+       * @return the number of nodes in the given subtree.
+       */
+      static size_t subtree_size(const node_type* node) {
+        return (node ? node->size : 0);
+      }
+
+      /**
+       * @brief Recomputes the size of the given node from the size
+       * of its children, when nodes store the size of their subtree.
+       * @param node the node to update.
+       */
+      static void update_size(node_type* node) {
+        if constexpr (is_order_statistic) {
+          node->size = 1 + subtree_size(node->left) + subtree_size(node->right);
+        }
+      }
+
+      /**
+       * @brief Counts the values of the tree less than the given key.
+       * @param key the key to compare values with.
+       * @param inclusive whether values equal to the key are counted.
+       * @return the number of matching values.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      size_t count_below(const Key& key, bool inclusive) const {
+        const node_type* node = this->root_;
+        size_t count = 0;
+
+        while (node) {
+          int result = this->options.compare(key, node->value());
+
+          if (result < 0 || (result == 0 && !inclusive)) {
+            node = node->left;
+          } else {
+            count += subtree_size(node->left) + 1;
+            node = node->right;
+          }
+        }
+        return (count);
+      }
+
+      /**
+       * @brief Hints the processor to fetch the given node into the cache.
+       * @param node the node about to be visited.
+       */
+      static void prefetch(const node_type* node) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(node);
+#else
+        (void) node;
+#endif
+      }
+
+      /**
+       * @brief Allocates and constructs a new node.
+       * @param args the arguments forwarded to the constructor of the value.
+       * @return a pointer to the new node.
+       */
+      template <typename... Args>
+      node_type* create_node(Args&&... args) {
+        node_type* node = allocator_traits::allocate(this->allocator, 1);
+
+        try {
+          allocator_traits::construct(this->allocator, node, std::in_place, std::forward<Args>(args)...);
+        } catch (...) {
+          allocator_traits::deallocate(this->allocator, node, 1);
+          throw;
+        }
+        return (node);
+      }
+
+      /**
+       * @brief Destroys and deallocates the given node.
+       * @param node the node to destroy.
+       */
+      void destroy_node(node_type* node) {
+        allocator_traits::destroy(this->allocator, node);
+        allocator_traits::deallocate(this->allocator, node, 1);
+      }
+
+      /**
+       * @brief Hands the given unlinked node over to the given domain,
+       * which destroys it from any thread, possibly after the tree.
+       * @param node the node to retire.
+       * @param domain the domain reclaiming the node.
+       */
+      void retire(node_type* node, epoch_domain_t& domain) {
+        static_assert(
+          allocator_traits::is_always_equal::value && std::is_default_constructible_v<node_allocator_type>,
+          "nodes can only be reclaimed by a domain using a stateless allocator"
+        );
+        domain.retire(node, [] (void* pointer) {
+          node_allocator_type allocator;
+          allocator_traits::destroy(allocator, static_cast<node_type*>(pointer));
+          allocator_traits::deallocate(allocator, static_cast<node_type*>(pointer), 1);
+        });
+      }
+
+      /**
+       * @brief A helper function to attach a node to another node.
+       * @param node the node to attach the new node to, or NULL if the
+       * new node becomes the root of an empty tree.
+       * @param new_node the node to attach.
+       * @param direction whether the new node should be attached to the left or right.
+       * @return a pointer to the newly attached node.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      node_type* attach(node_type* node, node_type* new_node, direction_t direction) {
+        if (!node)
+          this->root_ = new_node;
+        else if (direction == LEFT)
+          node->left = new_node;
+        else
+          node->right = new_node;
+        new_node->parent = node;
+        this->size_of_tree++;
+        this->balance.on_insert(*this, new_node);
+        return (new_node);
+      }
+
+      /**
+       * @return the depth of the deepest leaves of a tree of minimal
+       * height holding the given number of nodes, i.e log2(size).
+       */
+      static size_t max_depth_of(size_t size) {
+        size_t depth = 0;
+
+        for (; size > 1; size >>= 1) {
+          depth++;
+        }
+        return (depth);
+      }
+
+      /**
+       * @return the allocator the nodes of the tree are reallocated from, i.e
+       * a new default-constructed allocator if the allocator of the tree
+       * releases all its allocations at once, the allocator of the tree otherwise.
+       */
+      node_allocator_type fresh_allocator() const {
+        if constexpr (is_releasable<node_allocator_type>::value) {
+          return (node_allocator_type());
+        } else {
+          return (this->allocator);
+        }
+      }
+
+      /**
+       * @brief Appends the nodes of the given subtree to `order` in van Emde
+       * Boas order, i.e its top `height / 2` levels in van Emde Boas order,
+       * followed by the subtrees rooted below them from left to right.
+       * @param node the root of the subtree.
+       * @param height the number of levels of the subtree to lay out.
+       * @param order the nodes laid out so far.
+       */
+      static void van_emde_boas(node_type* node, size_t height, std::vector<node_type*>& order) {
+        if (height == 1) {
+          order.push_back(node);
+          return;
+        }
+        size_t top = height / 2;
+        std::vector<std::pair<node_type*, size_t>> stack = {{node, 0}};
+        std::vector<node_type*> roots;
+
+        van_emde_boas(node, top, order);
+
+        // Gathering the roots of the bottom subtrees from left to right.
+        while (!stack.empty()) {
+          auto [current, depth] = stack.back();
+          stack.pop_back();
+
+          if (depth == top) {
+            roots.push_back(current);
+            continue;
+          }
+          for (auto child : {current->right, current->left}) {
+            if (child) {
+              stack.emplace_back(child, depth + 1);
+            }
+          }
+        }
+        for (auto root : roots) {
+          van_emde_boas(root, height - top, order);
+        }
+      }
+
+      /**
+       * @brief Visits the given subtree in post-order, following parent
+       * links so that no stack space is consumed.
+       * @param root the root of the subtree to visit.
+       * @param callback the function called with every node and its
+       * depth relative to `root`, once its children have been visited.
+       * @note Complexity is O(n) with O(1) extra space.
+       */
+      template <typename Node, typename Callback>
+      static void post_order(Node* root, Callback&& callback) {
+        Node* node = root;
+        Node* previous = root ? root->parent : nullptr;
+        size_t depth = 0;
+
+        while (node) {
+          Node* next = nullptr;
+
+          if (previous == node->parent) {
+            // Descending into the node from its parent.
+            next = node->left ? node->left : node->right;
+          } else if (previous == node->left) {
+            // Coming back from the left subtree.
+            next = node->right;
+          }
+
+          if (next) {
+            previous = node;
+            node = next;
+            depth++;
+          } else {
+            // Both subtrees have been visited.
+            callback(node, depth);
+            previous = node;
+            node = node == root ? nullptr : node->parent;
+            depth--;
+          }
+        }
+      }
+
+      /**
+       * @return the number of nodes in the given subtree, which is
+       * counted when nodes do not store the size of their subtree.
+       * @note Complexity is O(1) in order-statistic trees, O(n) otherwise.
+       */
+      static size_t count_nodes(const node_type* node) {
+        if constexpr (is_order_statistic) {
+          return (subtree_size(node));
+        } else {
+          size_t count = 0;
+          post_order(node, [&] (const node_type*, size_t) { count++; });
+          return (count);
+        }
+      }
+
+      /**
+       * @brief Rebuilds the given subtree into a complete subtree using
+       * the Day-Stout-Warren algorithm, which first turns the subtree into
+       * a sorted list of right children, then folds the list into a
+       * complete subtree through left rotations.
+       * @param node the root of the subtree to rebuild.
+       * @param size the number of nodes in the subtree.
+       * @note The balancing metadata of the nodes is left untouched.
+       * Complexity is O(size) with O(1) extra space.
+       */
+      void rebuild(node_type* node, size_t size) {
+        auto parent  = node->parent;
+        auto is_left = parent && parent->left == node;
+        auto root    = [&] () {
+          return (!parent ? this->root_ : is_left ? parent->left : parent->right);
+        };
+
+        // Rotating every left child into a list of right children.
+        for (node = root(); node;) {
+          if (node->left) {
+            this->rotate_right(node);
+            node = node->parent;
+          } else {
+            node = node->right;
+          }
+        }
+
+        // Folding the list into a perfect subtree, the remaining
+        // nodes forming the deepest level of the subtree.
+        size_t perfect = 1;
+        while (perfect * 2 + 1 <= size) {
+          perfect = perfect * 2 + 1;
+        }
+        this->compress(root(), size > perfect ? size - perfect : 0);
+        while (perfect > 1) {
+          perfect /= 2;
+          this->compress(root(), perfect);
+        }
+      }
+
+      /**
+       * @brief Performs a left rotation on every other node of the
+       * list of right children starting at the given node.
+       * @param node the first node of the list.
+       * @param count the number of rotations to perform.
+       * @note Complexity is O(count).
+       */
+      void compress(node_type* node, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          this->rotate_left(node);
+          node = node->parent->right;
+        }
+      }
+
+      /**
+       * @brief Links the given range of sorted nodes into a subtree
+       * of minimal height rooted at the middle of the range.
+       * @param nodes the sorted nodes.
+       * @param begin the index of the first node of the range.
+       * @param end the index following the last node of the range.
+       * @param parent the parent of the subtree.
+       * @param depth the depth of the root of the subtree.
+       * @param max_depth the depth of the deepest leaves of the tree.
+       * @return the root of the subtree, or NULL if the range is empty.
+       * @note Complexity is O(n), with a recursion depth of O(log(n)).
+       */
+      node_type* link(const std::vector<node_type*>& nodes, size_t begin, size_t end, node_type* parent, size_t depth, size_t max_depth) {
+        if (begin == end) {
+          return (nullptr);
+        }
+
+        auto middle = begin + (end - begin) / 2;
+        auto node   = nodes[middle];
+
+        node->parent = parent;
+        node->left   = this->link(nodes, begin, middle, node, depth + 1, max_depth);
+        node->right  = this->link(nodes, middle + 1, end, node, depth + 1, max_depth);
+        this->update_size(node);
+        this->balance.on_build(*this, node, depth, max_depth);
+        return (node);
+      }
+
+      /**
+       * @brief Links the given range of sorted nodes into a subtree of
+       * minimal height, the halves of the first levels being linked in
+       * parallel.
+       * @param forks the number of levels of the recursion left to fork.
+       * @param pool the thread pool linking the halves in parallel.
+       * @note Complexity is O(n) work with a span of O(n / 2^forks).
+       */
+      node_type* link(const std::vector<node_type*>& nodes, size_t begin, size_t end, node_type* parent, size_t depth, size_t max_depth, size_t forks, thread_pool_t& pool) {
+        if (!forks || begin == end) {
+          return (this->link(nodes, begin, end, parent, depth, max_depth));
+        }
+
+        auto middle = begin + (end - begin) / 2;
+        auto node   = nodes[middle];
+
+        node->parent = parent;
+        pool.fork_join(
+          [&] { node->left  = this->link(nodes, begin, middle, node, depth + 1, max_depth, forks - 1, pool); },
+          [&] { node->right = this->link(nodes, middle + 1, end, node, depth + 1, max_depth, forks - 1, pool); }
+        );
+        this->update_size(node);
+        this->balance.on_build(*this, node, depth, max_depth);
+        return (node);
+      }
+
+      /**
+       * @brief Sorts the given range with a merge sort whose
+       * halves are sorted in parallel while forks remain.
+       * @param first the iterator to the beginning of the range.
+       * @param last the iterator to the end of the range.
+       * @param less the comparison function.
+       * @param forks the number of levels of the recursion left to fork.
+       * @param pool the thread pool sorting the halves in parallel.
+       * @note Complexity is O(nlog(n)).
+       */
+      template <typename RandomIt, typename Less>
+      static void parallel_sort(RandomIt first, RandomIt last, const Less& less, size_t forks, thread_pool_t& pool) {
+        if (!forks || last - first < 4096) {
+          std::sort(first, last, less);
+          return;
+        }
+
+        auto middle = first + (last - first) / 2;
+        pool.fork_join(
+          [&] { parallel_sort(first, middle, less, forks - 1, pool); },
+          [&] { parallel_sort(middle, last, less, forks - 1, pool); }
+        );
+        std::inplace_merge(first, middle, last, less);
+      }
+
+      /**
+       * @brief Calls the given function with every index of the given
+       * range, the halves of the range being visited in parallel
+       * while forks remain.
+       * @param begin the first index of the range.
+       * @param end the index following the last index of the range.
+       * @param forks the number of levels of the recursion left to fork.
+       * @param pool the thread pool visiting the halves in parallel.
+       * @param function the function to call.
+       */
+      template <typename Function>
+      static void parallel_for(size_t begin, size_t end, size_t forks, thread_pool_t& pool, const Function& function) {
+        if (!forks || end - begin < 4096) {
+          for (size_t i = begin; i < end; ++i) {
+            function(i);
+          }
+          return;
+        }
+
+        auto middle = begin + (end - begin) / 2;
+        pool.fork_join(
+          [&] { parallel_for(begin, middle, forks - 1, pool, function); },
+          [&] { parallel_for(middle, end, forks - 1, pool, function); }
+        );
+      }
+
+      /**
+       * @brief Replaces the subtree rooted at `node` with the
+       * subtree rooted at `replacement` in the parent of `node`.
+       * @param node the node to replace.
+       * @param replacement the node to put in place of `node`, can be null.
+       */
+      void transplant(node_type* node, node_type* replacement) {
+        if (!node->parent)
+          this->root_ = replacement;
+        else if (node == node->parent->left)
+          node->parent->left = replacement;
+        else
+          node->parent->right = replacement;
+        if (replacement)
+          replacement->parent = node->parent;
+      }
+
+      /**
+       * @brief Rotates the given node to the left, its right
+       * child taking its place.
+       * @param node the node to rotate.
+       * @note Complexity is O(1).
+       */
+      void rotate_left(node_type* node) {
+        auto pivot = node->right;
+
+        node->right = pivot->left;
+        if (pivot->left)
+          pivot->left->parent = node;
+        this->transplant(node, pivot);
+        pivot->left  = node;
+        node->parent = pivot;
+        if constexpr (is_order_statistic) {
+          // The pivot now roots the subtree of the node.
+          pivot->size = node->size;
+          this->update_size(node);
+        }
+      }
+
+      /**
+       * @brief Rotates the given node to the right, its left
+       * child taking its place.
+       * @param node the node to rotate.
+       * @note Complexity is O(1).
+       */
+      void rotate_right(node_type* node) {
+        auto pivot = node->left;
+
+        node->left = pivot->right;
+        if (pivot->right)
+          pivot->right->parent = node;
+        this->transplant(node, pivot);
+        pivot->right = node;
+        node->parent = pivot;
+        if constexpr (is_order_statistic) {
+          // The pivot now roots the subtree of the node.
+          pivot->size = node->size;
+          this->update_size(node);
+        }
+      }
+
+      /**
+       * @brief Unlinks the given node from the tree, lets the balancing
+       * policy restore its invariants, and destroys the node.
+       * @param node the node to erase.
+       * @return a pointer to the in-order successor of the erased node,
+       * or a NULL value if there is no successor.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      node_type* erase(node_type* node) {
+        auto successor = this->unlink(node);
+
+        this->destroy_node(node);
+        return (successor);
+      }
+
+      /**
+       * @brief Unlinks the given node from the tree, and lets the
+       * balancing policy restore its invariants. The node is not destroyed.
+       * @param node the node to unlink.
+       * @return a pointer to the in-order successor of the unlinked node,
+       * or a NULL value if there is no successor.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      node_type* unlink(node_type* node) {
+        node_type* successor = nullptr;
+        node_type* child     = nullptr;
+        node_type* parent    = nullptr;
+
+        // Finding the in-order successor of the node.
+        if (node->right) {
+          successor = const_cast<node_type*>(this->min(node->right));
+        } else {
+          successor = node->parent;
+          for (auto current = node; successor && current == successor->right; successor = successor->parent)
+            current = successor;
+        }
+
+        if (!node->left || !node->right) {
+          // The node has at most one child, which takes its place.
+          child  = node->left ? node->left : node->right;
+          parent = node->parent;
+          this->transplant(node, child);
+        } else {
+          // The node has two children, its successor takes its place.
+          child = successor->right;
+          if (successor->parent == node) {
+            parent = successor;
+          } else {
+            parent = successor->parent;
+            this->transplant(successor, successor->right);
+            successor->right = node->right;
+            successor->right->parent = successor;
+          }
+          this->transplant(node, successor);
+          successor->left = node->left;
+          successor->left->parent = successor;
+          // The successor inherits the balancing metadata of the
+          // position it now occupies.
+          std::swap(
+            static_cast<typename Balance::metadata_t&>(*successor),
+            static_cast<typename Balance::metadata_t&>(*node)
+          );
+        }
+
+        this->size_of_tree--;
+        this->balance.on_remove(*this, node, child, parent);
+        return (successor);
+      }
+
+      /**
+       * @brief Joins two detached subtrees under a detached node using
+       * the balancing policy, making the result the root of the tree.
+       * @param left the root of the lower subtree, can be null.
+       * @param middle the node to join the subtrees with, whose value is
+       * greater than the values of `left` and less than the values of `right`.
+       * @param right the root of the upper subtree, can be null.
+       * @note The size of the tree is left untouched.
+       */
+      void join(node_type* left, node_type* middle, node_type* right) {
+        if (left)
+          left->parent = nullptr;
+        if (right)
+          right->parent = nullptr;
+        this->balance.on_join(*this, left, middle, right);
+      }
+
+      /**
+       * @brief Links a detached node along the spine of a detached subtree,
+       * in place of the first node matching the given predicate, which
+       * becomes its child. The other subtree becomes its child on the side
+       * of the spine, and the spine subtree becomes the root of the tree.
+       * @param spine the root of the subtree to walk down.
+       * @param middle the node to link.
+       * @param other the root of the subtree to link under `middle`.
+       * @param direction the side of the spine to follow, which is the
+       * side of `other` relative to the values of `spine`.
+       * @param stop the predicate called with the nodes of the spine,
+       * which is never called with NULL.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Stop>
+      void graft(node_type* spine, node_type* middle, node_type* other, direction_t direction, Stop&& stop) {
+        node_type* parent = nullptr;
+        node_type* node   = spine;
+
+        while (node && !stop(node)) {
+          parent = node;
+          node = direction == LEFT ? node->left : node->right;
+        }
+
+        this->root_ = parent ? spine : middle;
+        if (parent && direction == LEFT)
+          parent->left = middle;
+        else if (parent)
+          parent->right = middle;
+
+        middle->parent = parent;
+        middle->left   = direction == LEFT ? other : node;
+        middle->right  = direction == LEFT ? node : other;
+        if (node)
+          node->parent = middle;
+        if (other)
+          other->parent = middle;
+
+        this->update_size(middle);
+        if constexpr (is_order_statistic) {
+          // The ancestors of the node gain it along with the other subtree.
+          for (auto ancestor = parent; ancestor; ancestor = ancestor->parent) {
+            ancestor->size += 1 + subtree_size(other);
+          }
+        }
+      }
+
+      /**
+       * @brief Joins two detached subtrees without a middle node, the
+       * largest node of `left` being unlinked to join them.
+       * @param left the root of the lower subtree, can be null.
+       * @param right the root of the upper subtree, can be null.
+       * @return the root of the joined subtree.
+       * @note The size of the tree is left untouched.
+       * Complexity is O(log(n)) in red-black and AVL trees.
+       */
+      node_type* concatenate(node_type* left, node_type* right) {
+        if (!left || !right) {
+          return (left ? left : right);
+        }
+
+        auto middle = const_cast<node_type*>(this->max(left));
+        left->parent = nullptr;
+        this->root_ = left;
+        this->unlink(middle);
+        this->size_of_tree++;
+        this->join(this->root_, middle, right);
+        return (this->root_);
+      }
+
+      /**
+       * @brief Splits the given detached subtree around a key, by joining
+       * in this tree the subtrees hanging off the search path of the key.
+       * @param root the root of the subtree to split, can be null.
+       * @param key the key to split the subtree around.
+       * @return the root of the subtree of values less than the key, the
+       * unlinked node equal to the key if any, and the root of the subtree
+       * of values greater than the key. The children of the node equal to
+       * the key do not take part in any join, and keep linking to it.
+       * @note Complexity is O(log(n)) in red-black and AVL trees.
+       */
+      template <typename Key>
+      std::tuple<node_type*, node_type*, node_type*> divide(node_type* root, const Key& key) {
+        node_type* lower = nullptr;
+        node_type* equal = nullptr;
+        node_type* upper = nullptr;
+
+        if (!root) {
+          return {lower, equal, upper};
+        }
+        root->parent = nullptr;
+
+        auto [node, result] = this->locate(key, root);
+        bool is_upper = result < 0;
+
+        if (result == 0) {
+          // The node equal to the key takes no part in the joins.
+          auto parent = node->parent;
+
+          equal = node;
+          lower = node->left;
+          upper = node->right;
+          is_upper = parent && parent->left == node;
+          node->left = node->right = node->parent = nullptr;
+          node = parent;
+        }
+
+        // Walking up the search path, every node joins its subtree
+        // away from the key with the part of its other subtree.
+        while (node) {
+          auto parent  = node->parent;
+          auto is_left = parent && parent->left == node;
+
+          if (is_upper) {
+            this->join(upper, node, node->right);
+            upper = this->root_;
+          } else {
+            this->join(node->left, node, lower);
+            lower = this->root_;
+          }
+          is_upper = is_left;
+          node = parent;
+        }
+        return {lower, equal, upper};
+      }
+
+      /**
+       * @brief Makes the given detached subtree the root of the tree, whose
+       * size must account for it. A subtree which did not take part in any
+       * join, whose root still links to its former parent, is joined with
+       * its largest node so that the balancing policy restores the
+       * invariants of its root, e.g its color.
+       * @param root the root of the subtree, can be null.
+       * @note Complexity is O(log(n)) in red-black and AVL trees.
+       */
+      void adopt(node_type* root) {
+        this->root_ = root;
+        if (root && root->parent) {
+          auto middle = const_cast<node_type*>(this->max(root));
+
+          root->parent = nullptr;
+          this->unlink(middle);
+          this->join(this->root_, middle, nullptr);
+          this->size_of_tree++;
+        }
+      }
+
+      /**
+       * @brief Constructs an empty tree sharing the options and the
+       * allocator of another tree.
+       */
+      tree_t(const Options& options, const node_allocator_type& allocator, std::in_place_t):
+        root_{nullptr}, size_of_tree{0}, options{options}, allocator{allocator} {}
+
+      /**
+       * @return an empty tree in which detached subtrees of this
+       * tree can be joined, whose root must be reset before it is destroyed.
+       */
+      tree_t scratch() const {
+        return (tree_t(this->options, this->allocator, std::in_place));
+      }
+
+      /**
+       * @return the number of levels of the recursion of the set
+       * operations whose halves are offered to the given pool.
+       */
+      static size_t forks_of(const thread_pool_t& pool) {
+        return (pool.size() ? max_depth_of(pool.size()) + 4 : 0);
+      }
+
+      /**
+       * @brief Runs the halves of a set operation, `right` being run in
+       * parallel in its own scratch tree while forks remain.
+       * @param forks the number of levels of the recursion left to fork.
+       * @param pool the thread pool running the halves in parallel.
+       * @param garbage the nodes left to destroy by the calling thread.
+       * @param left the half run in this tree.
+       * @param right the half offered to the pool.
+       */
+      template <typename Left, typename Right>
+      void fork(size_t forks, thread_pool_t& pool, std::vector<node_type*>& garbage, Left&& left, Right&& right) {
+        if (!forks) {
+          left(*this, garbage);
+          right(*this, garbage);
+          return;
+        }
+
+        auto scratch = this->scratch();
+        std::vector<node_type*> collected;
+
+        pool.fork_join([&] { left(*this, garbage); }, [&] { right(scratch, collected); });
+        scratch.root_ = nullptr;
+        garbage.insert(garbage.end(), collected.begin(), collected.end());
+      }
+
+      /**
+       * @brief Unites two detached subtrees, the nodes of `lhs` being kept
+       * over the nodes of `rhs` holding equal values.
+       * @return the root of the united subtree.
+       */
+      node_type* unite(node_type* lhs, node_type* rhs, size_t forks, thread_pool_t& pool, std::vector<node_type*>& garbage) {
+        if (!lhs || !rhs) {
+          return (lhs ? lhs : rhs);
+        }
+
+        node_type *lower, *equal, *upper;
+        std::tie(lower, equal, upper) = this->divide(lhs, rhs->value());
+        auto left  = rhs->left;
+        auto right = rhs->right;
+        auto next  = forks ? forks - 1 : 0;
+
+        this->fork(forks, pool, garbage,
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { left = tree.unite(lower, left, next, pool, nodes); },
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { right = tree.unite(upper, right, next, pool, nodes); }
+        );
+
+        auto middle = rhs;
+        if (equal) {
+          rhs->left = rhs->right = rhs->parent = nullptr;
+          garbage.push_back(rhs);
+          middle = equal;
+        }
+        this->join(left, middle, right);
+        return (this->root_);
+      }
+
+      /**
+       * @brief Intersects a detached subtree with a subtree of another tree,
+       * the subtrees of `lhs` holding no value of `rhs` being collected.
+       * @return the root of the intersected subtree.
+       */
+      node_type* intersect(node_type* lhs, const node_type* rhs, size_t forks, thread_pool_t& pool, std::vector<node_type*>& garbage) {
+        if (!lhs) {
+          return (nullptr);
+        }
+        if (!rhs) {
+          lhs->parent = nullptr;
+          garbage.push_back(lhs);
+          return (nullptr);
+        }
+
+        node_type *lower, *equal, *upper;
+        std::tie(lower, equal, upper) = this->divide(lhs, rhs->value());
+        node_type* left  = nullptr;
+        node_type* right = nullptr;
+        auto next = forks ? forks - 1 : 0;
+
+        this->fork(forks, pool, garbage,
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { left = tree.intersect(lower, rhs->left, next, pool, nodes); },
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { right = tree.intersect(upper, rhs->right, next, pool, nodes); }
+        );
+
+        if (equal) {
+          this->join(left, equal, right);
+          return (this->root_);
+        }
+        return (this->concatenate(left, right));
+      }
+
+      /**
+       * @brief Removes the values of a subtree of another tree from a
+       * detached subtree, the nodes holding these values being collected.
+       * @return the root of the resulting subtree.
+       */
+      node_type* subtract(node_type* lhs, const node_type* rhs, size_t forks, thread_pool_t& pool, std::vector<node_type*>& garbage) {
+        if (!lhs || !rhs) {
+          return (lhs);
+        }
+
+        node_type *lower, *equal, *upper;
+        std::tie(lower, equal, upper) = this->divide(lhs, rhs->value());
+        node_type* left  = nullptr;
+        node_type* right = nullptr;
+        auto next = forks ? forks - 1 : 0;
+
+        this->fork(forks, pool, garbage,
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { left = tree.subtract(lower, rhs->left, next, pool, nodes); },
+          [&] (tree_t& tree, std::vector<node_type*>& nodes) { right = tree.subtract(upper, rhs->right, next, pool, nodes); }
+        );
+
+        if (equal) {
+          garbage.push_back(equal);
+        }
+        return (this->concatenate(left, right));
+      }
+
+      /**
+       * @brief Moves the values of `other`, which shares the allocator of
+       * the tree, into the tree using the join-based union.
+       * @param other the tree to move the values from, which is left empty.
+       * @param pool the thread pool running the halves in parallel.
+       */
+      void absorb(tree_t&& other, thread_pool_t& pool) {
+        auto scratch = this->scratch();
+        std::vector<node_type*> garbage;
+        auto root = scratch.unite(this->root_, other.root_, forks_of(pool), pool, garbage);
+
+        scratch.root_ = nullptr;
+        this->size_of_tree += other.size_of_tree;
+        other.root_ = nullptr;
+        other.size_of_tree = 0;
+        this->settle(root, garbage);
+      }
+
+      /**
+       * @brief Destroys the nodes collected by a set operation, and makes
+       * the resulting subtree the root of the tree.
+       * @param root the root of the resulting subtree.
+       * @param garbage the roots of the detached subtrees to destroy.
+       */
+      void settle(node_type* root, const std::vector<node_type*>& garbage) {
+        this->root_ = nullptr;
+        for (auto node : garbage) {
+          this->clear(node);
+        }
+        this->adopt(root);
+      }
+
+      /**
+       * @brief Looks up the position of the given key in the tree.
+       * @param key the key to look up.
+       * @return the node associated with the key, or the node under which
+       * the key should be attached, along with the result of the comparison
+       * of the key with that node. The node is NULL if the tree is empty.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      std::pair<node_type*, int> locate(const Key& key) const {
+        return (this->locate(key, this->root_));
+      }
+
+      /**
+       * @brief Looks up the position of the given key in the given subtree.
+       * @param key the key to look up.
+       * @param node the root of the subtree.
+       * @return the node associated with the key, or the node under which
+       * the key should be attached, along with the result of the comparison
+       * of the key with that node. The node is NULL if the subtree is empty.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      std::pair<node_type*, int> locate(const Key& key, node_type* node) const {
+        int result = 0;
+
+        while (node) {
+          result = this->options.compare(key, node->value());
+
+          if (result < 0 && node->left)
+            node = node->left;
+          else if (result > 0 && node->right)
+            node = node->right;
+          else
+            break;
+        }
+        return {node, result};
+      }
+  };
+
+  // Definition of the depth-first search iterator.
+  template <typename Tree>
+  class dfs_iterator_t : public std::iterator<std::bidirectional_iterator_tag, typename Tree::value_type> {
+
+    // Iterator types.
+    using T    = typename Tree::value_type;
+    using node = typename Tree::node_type;
+
+    // Iterator members.
+    const node* ptr;
+    const Tree* tree;
+
+    public:
+
+      /**
+       * @brief Construct a new depth-first iterator.
+       * @param node the node to start the iteration from.
+       * @param tree the tree to iterate over.
+       */
+      dfs_iterator_t(const node* node, const Tree* tree): ptr{node}, tree{tree} {}
+
+      /**
+       * @brief Construct a new depth-first iterator.
+       */
+      dfs_iterator_t(): ptr{nullptr}, tree{nullptr} {}
+
+      /**
+       * @brief Compares two iterators for equality.
+       * @param other the iterator to compare with.
+       * @return true if the iterators are equal, false otherwise.
+       */
+      bool operator==(const dfs_iterator_t& other) const {
+        return (this->tree == other.tree && this->ptr == other.ptr);
+      }
+
+      /**
+       * @brief Compares two iterators for inequality.
+       * @param other the iterator to compare with.
+       * @return true if the iterators are not equal, false otherwise.
+       */
+      bool operator!=(const dfs_iterator_t& other) const {
+        return (this->tree != other.tree || this->ptr != other.ptr);
+      }
+
+      /**
+       * @brief De-references the iterator.
+       * @return the value of the node currently iterated over.
+       * If the iteration ended, an exception is thrown.
+       */
+      const T& operator*() const {
+        if (!this->ptr) {
+            throw std::out_of_range("Iterator is out of range");
+        }
+        return (this->ptr->value());
+      }
+  
+      /**
+       * @brief Increments the iterator.
+       * @return a reference to the iterator.
+       */
+      dfs_iterator_t& operator++() {
+        if (this->ptr == nullptr) {
+          // Initialize the node pointer to the root node of the tree.
+          this->ptr = this->tree->root_;
+          // If the tree is empty, we raise an exception.
+          if (!this->ptr) {
+            throw std::out_of_range("Iterator is out of range");
+          }
+          // Initializing the node to the smallest node
+          // in the binary search tree.
+          this->ptr = this->tree->min(this->ptr);
+        } else {
+          // If a right node exist, we iterate right,
+          // and we iterate again to the node with the smallest value.
+          if (this->ptr->right) {
+            this->ptr = this->tree->min(this->ptr->right);
+          } else {
+            auto node = this->ptr->parent;
+            // If no right node exists, we iterate upwards until
+            // we find a node with a left node.
+            while (node && this->ptr == node->right) {
+              this->ptr = node;
+              node = node->parent;
+            }
+            this->ptr = node;
+          }
+        }
+        return (*this);
+      }
+
+      /**
+       * @brief Postfix increment operator.
+       * @return a copy of the iterator before incrementing it.
+       */
+      dfs_iterator_t operator++(int) {
+        dfs_iterator_t tmp = *this;
+        ++(*this);
+        return (tmp);
+      }
+
+      /**
+       * @brief Decrements the iterator.
+       * @return a reference to the iterator.
+       */
+      dfs_iterator_t& operator--() {
+        if (this->ptr == nullptr) {
+          // Initialize the node pointer to the root node of the tree.
+          this->ptr = this->tree->root_;
+          // If the tree is empty, we raise an exception.
+          if (!this->ptr) {
+            throw std::out_of_range("Iterator is out of range");
+          }
+          // Initializing the node to the biggest node
+          // in the binary search tree.
+          this->ptr = this->tree->max(this->ptr);
+        } else {
+          // If a left node exist, we iterate left,
+          // and we iterate until we find the node with
+          // the biggest value in the left subtree.
+          if (this->ptr->left) {
+            this->ptr = this->tree->max(this->ptr->left);
+          } else {
+            auto node = this->ptr->parent;
+            // If no left node exists, we iterate upwards until
+            // we find a node with a right node.
+            while (node && this->ptr == node->left) {
+              this->ptr = node;
+              node = node->parent;
+            }
+            this->ptr = node;
+          }
+        }
+        return (*this);
+      }
+
+      /**
+       * @brief Postfix decrement operator.
+       * @return a copy of the iterator before decrementing it.
+       */
+      dfs_iterator_t operator--(int) {
+        dfs_iterator_t tmp = *this;
+        --(*this);
+        return (tmp);
+      }
+  };
+
+  /**
+   * @brief Describes a binary-search tree node
+   * attributes.
+   * @note The node inherits from the metadata required by the balancing
+   * policy of its tree, which takes no space for unbalanced trees.
+   */
+  template <typename T, typename Metadata>
+  struct node_t : public Metadata {
+
+    /**
+     * @brief Node constructor.
+     * @param data The data to be stored in the node.
+     */
+    node_t(const T& data) :
+      Metadata{}, data{data}, left{nullptr}, right{nullptr}, parent{nullptr} {}
+
+    /**
+     * @brief Node move constructor.
+     * @param data The data to be moved to the node.
+     */
+    node_t(T&& data) :
+      Metadata{}, data{std::move(data)}, left{nullptr}, right{nullptr}, parent{nullptr} {}
+
+    /**
+     * @brief Node in-place constructor.
+     * @param args The arguments forwarded to the constructor of the data.
+     */
+    template <typename... Args>
+    node_t(std::in_place_t, Args&&... args) :
+      Metadata{}, data(std::forward<Args>(args)...), left{nullptr}, right{nullptr}, parent{nullptr} {}
+
+    /**
+     * @return a reference to the data stored by the node.
+     */
+    const T& value() const {
+      return (this->data);
+    }
+
+    T       data;
+    node_t* left;
+    node_t* right;
+    node_t* parent;
+  };
+
+  /**
+   * @brief A binary-search tree balanced as a red-black tree.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  using red_black_tree_t = tree_t<T, red_black_t, Options>;
+
+  /**
+   * @brief A binary-search tree balanced as an AVL tree.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  using avl_tree_t = tree_t<T, avl_t, Options>;
+
+  /**
+   * @brief A binary-search tree balanced as a scapegoat tree,
+   * whose nodes do not store any balancing metadata.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  using scapegoat_tree_t = tree_t<T, scapegoat_t, Options>;
+
+  /**
+   * @brief A binary-search tree balanced as a splay tree, moving
+   * inserted and looked up values to the root.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  using splay_tree_t = tree_t<T, splay_t, Options>;
+
+  /**
+   * @brief A binary-search tree storing the size of every subtree,
+   * supporting `select`, `rank` and `count_range` in O(log(n)).
+   */
+  template <typename T, typename Balance = red_black_t, typename Options = default_options_t<T>>
+  using order_statistic_tree_t = tree_t<T, order_statistic_t<Balance>, Options>;
+
+  /**
+   * @brief A binary-search tree allocating its nodes from
+   * an arena, which is released at once when the tree is cleared.
+   */
+  template <typename T, typename Balance = unbalanced_t, typename Options = default_options_t<T>>
+  using arena_tree_t = tree_t<T, Balance, Options, arena_allocator_t<T>>;
+
+  /**
+   * @brief Joins two trees whose values are key-disjoint.
+   * @param left the tree holding the lower values.
+   * @param right the tree holding the upper values.
+   * @return a tree holding the nodes of both trees, which are left empty.
+   * @throws std::invalid_argument if the trees do not share the same
+   * allocator, or if their values overlap.
+   * @note Complexity is O(log(n)) in red-black and AVL trees.
+   */
+  template <typename T, typename Balance, typename Options, typename Allocator, template <typename> class DefaultIterator>
+  tree_t<T, Balance, Options, Allocator, DefaultIterator> join(
+    tree_t<T, Balance, Options, Allocator, DefaultIterator>&& left,
+    tree_t<T, Balance, Options, Allocator, DefaultIterator>&& right
+  ) {
+    left.join(std::move(right));
+    return (std::move(left));
+  }
+
+  /**
+   * @brief Deduces the type of a tree created from options,
+   * e.g `tree_t(options_t<T>(...))` for type-erased options.
+   */
+  template <typename T, typename Comparator, typename Stringifier>
+  tree_t(const options_t<T, Comparator, Stringifier>&) -> tree_t<T, unbalanced_t, options_t<T, Comparator, Stringifier>>;
+
+  /**
+   * @brief A lock protecting a node with a version, which readers
+   * validate instead of acquiring the lock, and restart from when
+   * a writer modified the node in the meantime.
+   */
+  class optimistic_lock_t {
+
+    public:
+
+      /**
+       * @brief Reads the version of the lock, waiting for the
+       * writer holding it, if any, to release it.
+       * @param version the version read.
+       * @return whether the node is still linked in the tree.
+       */
+      bool read(uint64_t& version) const {
+        version = this->version.load(std::memory_order_acquire);
+        while (version & LOCKED) {
+          std::this_thread::yield();
+          version = this->version.load(std::memory_order_acquire);
+        }
+        return (!(version & OBSOLETE));
+      }
+
+      /**
+       * @return whether the node was not modified since
+       * the given version was read.
+       */
+      bool validate(uint64_t version) const {
+        return (this->version.load(std::memory_order_acquire) == version);
+      }
+
+      /**
+       * @brief Acquires the lock if the node was not
+       * modified since the given version was read.
+       * @return whether the lock was acquired.
+       */
+      bool upgrade(uint64_t version) {
+        return (this->version.compare_exchange_strong(version, version + LOCKED, std::memory_order_acquire));
+      }
+
+      /**
+       * @brief Releases the lock, bumping the version.
+       */
+      void unlock() {
+        this->version.fetch_add(LOCKED, std::memory_order_release);
+      }
+
+      /**
+       * @brief Releases the lock of a node unlinked from the tree,
+       * so that readers holding it restart.
+       */
+      void unlock_obsolete() {
+        this->version.fetch_add(LOCKED | OBSOLETE, std::memory_order_release);
+      }
+
+    private:
+
+      // Set on nodes unlinked from the tree.
+      static constexpr uint64_t OBSOLETE = 1;
+      // Set while a writer holds the lock, releasing the lock
+      // carrying it over into the version counter.
+      static constexpr uint64_t LOCKED = 2;
+
+      std::atomic<uint64_t> version{0};
+  };
+
+  /**
+   * @brief A binary-search tree supporting concurrent lookups,
+   * insertions and removals using optimistic lock coupling.
+   *
+   * Values are stored in the leaves of an external tree, whose inner nodes
+   * hold a copy of a value separating their subtrees to route lookups.
+   * Readers never acquire a lock: they validate the version of every
+   * node they traverse, and restart from the root if a writer
+   * modified it. Writers only lock the parent of the leaf they insert
+   * below, or the parent and grand-parent of the leaf they remove.
+   *
+   * @tparam T the type of the values stored in the tree, which must
+   * be copy-constructible.
+   * @tparam Options the options used to compare values.
+   * @note The tree is not balanced, which keeps the nodes modified by
+   * writers local, and has a worst-case height of O(n) for sorted input.
+   * Unlinked nodes may still be traversed by readers, and are reclaimed
+   * through an epoch domain once no reader may hold them anymore.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  class concurrent_tree_t {
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * @brief Construct a new concurrent binary-search tree object.
+       * @param options the options to associate to the tree.
+       * @param domain the domain reclaiming the unlinked nodes,
+       * which must outlive the tree.
+       */
+      explicit concurrent_tree_t(const Options& options = Options(), epoch_domain_t& domain = default_epoch_domain()):
+        domain{domain}, options{options} {}
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      concurrent_tree_t(const concurrent_tree_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      concurrent_tree_t& operator=(const concurrent_tree_t&) = delete;
+
+      /**
+       * @brief Destroys the linked nodes, which requires
+       * the other threads to be done with the tree.
+       */
+      ~concurrent_tree_t() {
+        std::vector<node_type*> stack;
+
+        if (auto root = this->head.children[LEFT].load(std::memory_order_relaxed)) {
+          stack.push_back(root);
+        }
+        while (!stack.empty()) {
+          auto node = stack.back();
+          stack.pop_back();
+          if (!node->leaf) {
+            stack.push_back(node->children[LEFT].load(std::memory_order_relaxed));
+            stack.push_back(node->children[RIGHT].load(std::memory_order_relaxed));
+          }
+          delete node;
+        }
+      }
+
+      /**
+       * @brief Inserts the given `data` in the tree.
+       * @param data the data to insert.
+       * @return whether the data was inserted, i.e no equal value was found.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      bool insert(const T& data) {
+        return (this->insert_leaf(new node_type(true, data)));
+      }
+
+      /**
+       * @brief Moves the given `data` into the tree.
+       * @param data the data to move into the tree.
+       * @return whether the data was inserted, i.e no equal value was found,
+       * the data being moved in both cases.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      bool insert(T&& data) {
+        return (this->insert_leaf(new node_type(true, std::move(data))));
+      }
+
+      /**
+       * @brief Removes the value equal to the given `key` from the tree.
+       * @param key the key to look up.
+       * @return whether a value was removed.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      bool remove(const Key& key) {
+        auto guard = this->domain.pin();
+
+        while (true) {
+          position_t position;
+
+          if (!this->search(key, position)) {
+            continue;
+          }
+          auto leaf = position.leaf;
+          if (!leaf || this->options.compare(key, leaf->data)) {
+            return (false);
+          }
+
+          // Removing the only leaf of the tree.
+          if (position.parent == &this->head) {
+            if (!this->head.lock.upgrade(position.parent_version)) {
+              continue;
+            }
+            this->head.children[LEFT].store(nullptr, std::memory_order_release);
+            this->head.lock.unlock();
+            this->domain.retire(leaf);
+            this->size_of_tree.fetch_sub(1, std::memory_order_relaxed);
+            return (true);
+          }
+
+          // Replacing the parent of the leaf with the sibling of the leaf.
+          auto parent = static_cast<node_type*>(position.parent);
+          if (!position.grandparent->lock.upgrade(position.grandparent_version)) {
+            continue;
+          }
+          if (!parent->lock.upgrade(position.parent_version)) {
+            position.grandparent->lock.unlock();
+            continue;
+          }
+          auto sibling = parent->children[!position.direction].load(std::memory_order_relaxed);
+          position.grandparent->children[position.parent_direction].store(sibling, std::memory_order_release);
+          parent->lock.unlock_obsolete();
+          position.grandparent->lock.unlock();
+          this->domain.retire(parent);
+          this->domain.retire(leaf);
+          this->size_of_tree.fetch_sub(1, std::memory_order_relaxed);
+          return (true);
+        }
+      }
+
+      /**
+       * @brief Finds the value equal to the given `key`.
+       * @param key the key to look up.
+       * @return a copy of the value, or an empty optional
+       * if no value is equal to the key.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      std::optional<T> find(const Key& key) const {
+        auto guard = this->domain.pin();
+        position_t position;
+
+        while (!this->search(key, position));
+        if (!position.leaf || this->options.compare(key, position.leaf->data)) {
+          return {};
+        }
+        return (position.leaf->data);
+      }
+
+      /**
+       * @return whether a value is equal to the given `key`.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      bool contains(const Key& key) const {
+        auto guard = this->domain.pin();
+        position_t position;
+
+        while (!this->search(key, position));
+        return (position.leaf && !this->options.compare(key, position.leaf->data));
+      }
+
+      /**
+       * @return the number of values in the tree, which may be
+       * outdated by the time it is returned.
+       */
+      size_t size() const {
+        return (this->size_of_tree.load(std::memory_order_relaxed));
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->size() == 0);
+      }
+
+      /**
+       * @brief Calls the given `callback` with the values of the tree
+       * in ascending order.
+       * @param callback the function called with every value.
+       * @note Writers must not modify the tree during the traversal.
+       * Complexity is O(n).
+       */
+      template <typename Callback>
+      void for_each(Callback&& callback) const {
+        std::vector<const node_type*> stack;
+        auto node = this->head.children[LEFT].load(std::memory_order_acquire);
+
+        while (node || !stack.empty()) {
+          while (node && !node->leaf) {
+            stack.push_back(node);
+            node = node->children[LEFT].load(std::memory_order_acquire);
+          }
+          if (node) {
+            callback(node->data);
+          }
+          if (stack.empty()) {
+            return;
+          }
+          node = stack.back()->children[RIGHT].load(std::memory_order_acquire);
+          stack.pop_back();
+        }
+      }
+
+    private:
+
+      struct node_type;
+
+      /**
+       * @brief The part of a node that lookups traverse, which
+       * the head of the tree uses to link the root.
+       */
+      struct link_t {
+        mutable optimistic_lock_t lock;
+        std::atomic<node_type*> children[2] = {nullptr, nullptr};
+      };
+
+      /**
+       * @brief A node of the tree, which is either a leaf holding a value,
+       * or an inner node whose left subtree holds the values lower than
+       * its own, and whose right subtree holds the other values.
+       */
+      struct node_type : link_t {
+        template <typename... Args>
+        node_type(bool leaf, Args&&... args): leaf{leaf}, data(std::forward<Args>(args)...) {}
+
+        const bool leaf;
+        const T    data;
+      };
+
+      /**
+       * @brief Describes the leaf a lookup ended on, along with the
+       * versions of its parent and grand-parent when they were read.
+       */
+      struct position_t {
+        link_t*     grandparent = nullptr;
+        uint64_t    grandparent_version = 0;
+        direction_t parent_direction = LEFT;
+        link_t*     parent = nullptr;
+        uint64_t    parent_version = 0;
+        direction_t direction = LEFT;
+        node_type*  leaf = nullptr;
+      };
+
+      /**
+       * @brief Walks down the tree towards the leaf of the given `key`,
+       * validating the version of every traversed node.
+       * @param key the key to look up.
+       * @param position the position at which the lookup ended, `leaf`
+       * being NULL when the tree is empty.
+       * @return whether the lookup completed without encountering
+       * a modified node, or must be restarted.
+       */
+      template <typename Key>
+      bool search(const Key& key, position_t& position) const {
+        link_t*   parent = const_cast<link_t*>(&this->head);
+        uint64_t  parent_version;
+        direction_t direction = LEFT;
+
+        position = position_t();
+        parent->lock.read(parent_version);
+        auto node = parent->children[LEFT].load(std::memory_order_acquire);
+        while (node && !node->leaf) {
+          uint64_t version;
+
+          // The node must be read before the parent is validated, as the
+          // node may be unlinked as soon as its parent is modified.
+          if (!node->lock.read(version) || !parent->lock.validate(parent_version)) {
+            return (false);
+          }
+          position.grandparent = parent;
+          position.grandparent_version = parent_version;
+          position.parent_direction = direction;
+          parent = node;
+          parent_version = version;
+          direction = this->options.compare(key, node->data) < 0 ? LEFT : RIGHT;
+          node = node->children[direction].load(std::memory_order_acquire);
+        }
+        if (!parent->lock.validate(parent_version)) {
+          return (false);
+        }
+        position.parent = parent;
+        position.parent_version = parent_version;
+        position.direction = direction;
+        position.leaf = node;
+        return (true);
+      }
+
+      /**
+       * @brief Inserts the given leaf below its parent, creating an inner
+       * node routing lookups to it and to the leaf it lands on.
+       * @param leaf the leaf to insert, which is destroyed if
+       * an equal value already exists.
+       * @return whether the leaf was inserted.
+       */
+      bool insert_leaf(node_type* leaf) {
+        auto guard = this->domain.pin();
+
+        while (true) {
+          position_t position;
+
+          if (!this->search(leaf->data, position)) {
+            continue;
+          }
+
+          auto sibling = position.leaf;
+          auto result = sibling ? this->options.compare(leaf->data, sibling->data) : 0;
+          if (sibling && !result) {
+            delete leaf;
+            return (false);
+          }
+
+          // Creating the inner node before locking the parent.
+          node_type* node = leaf;
+          if (sibling) {
+            auto upper = result < 0 ? sibling : leaf;
+            try {
+              node = new node_type(false, upper->data);
+            } catch (...) {
+              delete leaf;
+              throw;
+            }
+            node->children[LEFT].store(result < 0 ? leaf : sibling, std::memory_order_relaxed);
+            node->children[RIGHT].store(upper, std::memory_order_relaxed);
+          }
+
+          if (!position.parent->lock.upgrade(position.parent_version)) {
+            if (node != leaf) {
+              delete node;
+            }
+            continue;
+          }
+          position.parent->children[position.direction].store(node, std::memory_order_release);
+          position.parent->lock.unlock();
+          this->size_of_tree.fetch_add(1, std::memory_order_relaxed);
+          return (true);
+        }
+      }
+
+      link_t              head;
+      std::atomic<size_t> size_of_tree{0};
+      epoch_domain_t&     domain;
+      Options             options;
+  };
+
+  /**
+   * @brief A lock-free binary-search tree, following the algorithm of
+   * Natarajan and Mittal.
+   *
+   * Values are stored in the leaves of an external tree, whose inner nodes
+   * hold a copy of a value separating their subtrees. A removal first flags
+   * the edge leading to its leaf, which linearizes it, then tags the edge
+   * leading to the sibling of the leaf so that it cannot change anymore,
+   * and swings the edge above the parent to the sibling. Operations finding
+   * a flagged or tagged edge on their way help completing the removal, so
+   * that no thread ever waits for another one.
+   *
+   * Removed nodes are reclaimed through an epoch domain once no
+   * operation may still hold them.
+   *
+   * @tparam T the type of the values stored in the tree, which must
+   * be copy-constructible.
+   * @tparam Options the options used to compare values.
+   * @note The tree is not balanced, and has a worst-case
+   * height of O(n) for sorted input.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  class lock_free_tree_t {
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * @brief Construct a new lock-free binary-search tree object.
+       * @param options the options to associate to the tree.
+       * @param domain the domain reclaiming the removed nodes,
+       * which must outlive the tree.
+       */
+      explicit lock_free_tree_t(const Options& options = Options(), epoch_domain_t& domain = default_epoch_domain()):
+        domain{domain}, options{options} {
+        // The sentinel nodes, whose keys are greater than any value.
+        this->root.children[LEFT].store(reinterpret_cast<uintptr_t>(new node_type(2)), std::memory_order_relaxed);
+        this->root.children[RIGHT].store(reinterpret_cast<uintptr_t>(new node_type(3)), std::memory_order_relaxed);
+        auto sentinel = address(this->root.children[LEFT].load(std::memory_order_relaxed));
+        sentinel->children[LEFT].store(reinterpret_cast<uintptr_t>(new node_type(1)), std::memory_order_relaxed);
+        sentinel->children[RIGHT].store(reinterpret_cast<uintptr_t>(new node_type(2)), std::memory_order_relaxed);
+      }
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      lock_free_tree_t(const lock_free_tree_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      lock_free_tree_t& operator=(const lock_free_tree_t&) = delete;
+
+      /**
+       * @brief Destroys the linked nodes, which requires
+       * the other threads to be done with the tree.
+       */
+      ~lock_free_tree_t() {
+        std::vector<node_type*> stack;
+
+        for (auto& child : this->root.children) {
+          stack.push_back(address(child.load(std::memory_order_relaxed)));
+        }
+        while (!stack.empty()) {
+          auto node = stack.back();
+          stack.pop_back();
+          if (!node->leaf()) {
+            stack.push_back(address(node->children[LEFT].load(std::memory_order_relaxed)));
+            stack.push_back(address(node->children[RIGHT].load(std::memory_order_relaxed)));
+          }
+          delete node;
+        }
+      }
+
+      /**
+       * @brief Inserts the given `data` in the tree.
+       * @param data the data to insert.
+       * @return whether the data was inserted, i.e no equal value was found.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      bool insert(const T& data) {
+        return (this->insert_leaf(new node_type(std::in_place, data)));
+      }
+
+      /**
+       * @brief Moves the given `data` into the tree.
+       * @param data the data to move into the tree.
+       * @return whether the data was inserted, i.e no equal value was found,
+       * the data being moved in both cases.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      bool insert(T&& data) {
+        return (this->insert_leaf(new node_type(std::in_place, std::move(data))));
+      }
+
+      /**
+       * @brief Removes the value equal to the given `key` from the tree.
+       * @param key the key to look up.
+       * @return whether a value was removed.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      bool remove(const Key& key) {
+        auto guard = this->domain.pin();
+        node_type* leaf = nullptr;
+
+        while (true) {
+          auto record = this->seek(key);
+          auto& field = record.parent->children[this->direction_of(key, record.parent)];
+
+          if (!leaf) {
+            // Flagging the edge leading to the leaf, which removes its value.
+            if (!this->matches(key, record.leaf)) {
+              return (false);
+            }
+            auto expected = reinterpret_cast<uintptr_t>(record.leaf);
+            if (field.compare_exchange_strong(expected, expected | FLAG)) {
+              leaf = record.leaf;
+              this->size_of_tree.fetch_sub(1, std::memory_order_relaxed);
+              if (this->cleanup(key, record)) {
+                return (true);
+              }
+            } else if (address(expected) == record.leaf && (expected & (FLAG | TAG))) {
+              this->cleanup(key, record);
+            }
+          } else if (record.leaf != leaf || this->cleanup(key, record)) {
+            // The leaf was unlinked, possibly by another operation.
+            return (true);
+          }
+        }
+      }
+
+      /**
+       * @brief Finds the value equal to the given `key`.
+       * @param key the key to look up.
+       * @return a copy of the value, or an empty optional
+       * if no value is equal to the key.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      std::optional<T> find(const Key& key) const {
+        auto guard = this->domain.pin();
+        auto leaf = this->seek(key).leaf;
+
+        if (!this->matches(key, leaf)) {
+          return {};
+        }
+        return (*leaf->data);
+      }
+
+      /**
+       * @return whether a value is equal to the given `key`.
+       * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+       */
+      template <typename Key>
+      bool contains(const Key& key) const {
+        auto guard = this->domain.pin();
+        return (this->matches(key, this->seek(key).leaf));
+      }
+
+      /**
+       * @return the number of values in the tree, which may be
+       * outdated by the time it is returned.
+       */
+      size_t size() const {
+        return (this->size_of_tree.load(std::memory_order_relaxed));
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->size() == 0);
+      }
+
+      /**
+       * @brief Calls the given `callback` with the values of the tree
+       * in ascending order.
+       * @param callback the function called with every value.
+       * @note Writers must not modify the tree during the traversal.
+       * Complexity is O(n).
+       */
+      template <typename Callback>
+      void for_each(Callback&& callback) const {
+        std::vector<const node_type*> stack;
+        const node_type* node = &this->root;
+
+        while (node || !stack.empty()) {
+          while (node && !node->leaf()) {
+            stack.push_back(node);
+            node = address(node->children[LEFT].load(std::memory_order_acquire));
+          }
+          if (node && !node->infinity) {
+            callback(*node->data);
+          }
+          if (stack.empty()) {
+            return;
+          }
+          node = address(stack.back()->children[RIGHT].load(std::memory_order_acquire));
+          stack.pop_back();
+        }
+      }
+
+    private:
+
+      // Marks the edge leading to a leaf being removed.
+      static constexpr uintptr_t FLAG = 1;
+      // Marks the edge leading to the sibling of a leaf being removed.
+      static constexpr uintptr_t TAG = 2;
+
+      /**
+       * @brief A node of the tree, which is either a leaf holding a value,
+       * or an inner node whose left subtree holds the values lower than
+       * its own, and whose right subtree holds the other values.
+       * Edges are stored as node addresses marked with `FLAG` and `TAG`.
+       */
+      struct node_type {
+        explicit node_type(int infinity): infinity{infinity} {}
+
+        template <typename... Args>
+        explicit node_type(std::in_place_t, Args&&... args): infinity{0}, data(std::in_place, std::forward<Args>(args)...) {}
+
+        /**
+         * @return whether the node is a leaf.
+         */
+        bool leaf() const {
+          return (!this->children[LEFT].load(std::memory_order_acquire));
+        }
+
+        std::atomic<uintptr_t> children[2] = {0, 0};
+        // The rank of the sentinel keys, which are greater than
+        // any value, or zero for nodes holding a value.
+        int                    infinity;
+        std::optional<T>       data;
+      };
+
+      /**
+       * @brief Describes the nodes a lookup went through: the leaf it ended
+       * on, its parent, and the last edge from `ancestor` to `successor`
+       * that was not tagged, which a removal swings to the sibling.
+       */
+      struct seek_record_t {
+        node_type* ancestor;
+        node_type* successor;
+        node_type* parent;
+        node_type* leaf;
+      };
+
+      /**
+       * @return the node at the given marked address.
+       */
+      static node_type* address(uintptr_t edge) {
+        return (reinterpret_cast<node_type*>(edge & ~(FLAG | TAG)));
+      }
+
+      /**
+       * @return the direction to follow from the given node to look up `key`.
+       */
+      template <typename Key>
+      direction_t direction_of(const Key& key, const node_type* node) const {
+        return (node->infinity || this->options.compare(key, *node->data) < 0 ? LEFT : RIGHT);
+      }
+
+      /**
+       * @return whether the given leaf holds a value equal to `key`.
+       */
+      template <typename Key>
+      bool matches(const Key& key, const node_type* leaf) const {
+        return (!leaf->infinity && this->options.compare(key, *leaf->data) == 0);
+      }
+
+      /**
+       * @brief Walks down the tree towards the leaf of the given `key`.
+       * @param key the key to look up.
+       * @return the nodes the lookup went through.
+       */
+      template <typename Key>
+      seek_record_t seek(const Key& key) const {
+        auto sentinel = address(this->root.children[LEFT].load(std::memory_order_acquire));
+        auto parent_edge = sentinel->children[LEFT].load(std::memory_order_acquire);
+        seek_record_t record{const_cast<node_type*>(&this->root), sentinel, sentinel, address(parent_edge)};
+        auto edge = record.leaf->children[this->direction_of(key, record.leaf)].load(std::memory_order_acquire);
+
+        while (address(edge)) {
+          if (!(parent_edge & TAG)) {
+            record.ancestor  = record.parent;
+            record.successor = record.leaf;
+          }
+          record.parent = record.leaf;
+          record.leaf   = address(edge);
+          parent_edge   = edge;
+          edge = record.leaf->children[this->direction_of(key, record.leaf)].load(std::memory_order_acquire);
+        }
+        return (record);
+      }
+
+      /**
+       * @brief Unlinks the parent of a flagged leaf, along with the nodes
+       * between the successor and the parent, by swinging the edge leading
+       * to the successor to the sibling of the leaf.
+       * @param key the key of the lookup that produced the record.
+       * @param record the nodes the lookup went through.
+       * @return whether the nodes were unlinked by this call.
+       */
+      template <typename Key>
+      bool cleanup(const Key& key, const seek_record_t& record) {
+        auto& successor_field = record.ancestor->children[this->direction_of(key, record.ancestor)];
+        auto direction = this->direction_of(key, record.parent);
+        auto sibling_field = &record.parent->children[!direction];
+
+        // When the leaf of the lookup is not flagged, its sibling is being
+        // removed, and the leaf is the node to keep.
+        if (!(record.parent->children[direction].load() & FLAG)) {
+          sibling_field = &record.parent->children[direction];
+        }
+        auto sibling  = sibling_field->fetch_or(TAG);
+        auto expected = reinterpret_cast<uintptr_t>(record.successor);
+        if (!successor_field.compare_exchange_strong(expected, sibling & ~TAG)) {
+          return (false);
+        }
+
+        // Every unlinked node has a flagged leaf, and a child on the path
+        // of the lookup, which is kept for the parent.
+        for (auto node = record.successor;;) {
+          auto next = node == record.parent ? address(sibling) : address(node->children[this->direction_of(key, node)].load());
+          auto left = address(node->children[LEFT].load());
+          this->domain.retire(left == next ? address(node->children[RIGHT].load()) : left);
+          this->domain.retire(node);
+          if (node == record.parent) {
+            return (true);
+          }
+          node = next;
+        }
+      }
+
+      /**
+       * @brief Inserts the given leaf below its parent, creating an inner
+       * node routing lookups to it and to the leaf it lands on.
+       * @param leaf the leaf to insert, which is destroyed if
+       * an equal value already exists.
+       * @return whether the leaf was inserted.
+       */
+      bool insert_leaf(node_type* leaf) {
+        auto guard = this->domain.pin();
+
+        while (true) {
+          auto record  = this->seek(*leaf->data);
+          auto sibling = record.leaf;
+
+          if (this->matches(*leaf->data, sibling)) {
+            delete leaf;
+            return (false);
+          }
+
+          // The inner node holds the greater value of both leaves.
+          auto lower = this->direction_of(*leaf->data, sibling) == LEFT;
+          node_type* node;
+          try {
+            node = sibling->infinity ? new node_type(sibling->infinity) : new node_type(std::in_place, *(lower ? sibling : leaf)->data);
+          } catch (...) {
+            delete leaf;
+            throw;
+          }
+          node->children[LEFT].store(reinterpret_cast<uintptr_t>(lower ? leaf : sibling), std::memory_order_relaxed);
+          node->children[RIGHT].store(reinterpret_cast<uintptr_t>(lower ? sibling : leaf), std::memory_order_relaxed);
+
+          auto& field = record.parent->children[this->direction_of(*leaf->data, record.parent)];
+          auto expected = reinterpret_cast<uintptr_t>(sibling);
+          if (field.compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node))) {
+            this->size_of_tree.fetch_add(1, std::memory_order_relaxed);
+            return (true);
+          }
+          delete node;
+
+          // Helping the removal preventing the insertion.
+          if (address(expected) == sibling && (expected & (FLAG | TAG))) {
+            this->cleanup(*leaf->data, record);
+          }
+        }
+      }
+
+      node_type           root{3};
+      std::atomic<size_t> size_of_tree{0};
+      epoch_domain_t&     domain;
+      Options             options;
+  };
+
+  /**
+   * @brief A persistent binary-search tree, balanced as an AVL tree.
+   *
+   * Nodes are immutable and reference-counted, so that a mutation copies
+   * the path from the root to the modified node, and shares the other
+   * subtrees with the previous version of the tree. Copying the tree,
+   * or taking a `snapshot()`, is O(1) and leaves the copy untouched by
+   * the later mutations of the tree.
+   *
+   * @tparam T the type of the values stored in the tree, which must
+   * be copy-constructible.
+   * @tparam Options the options used to compare values.
+   * @note Different trees sharing nodes can be used from different threads,
+   * e.g a reader iterating a snapshot while a writer mutates the tree, but
+   * a given tree must not be mutated and read concurrently.
+   */
+  template <typename T, typename Options = default_options_t<T>>
+  class persistent_tree_t {
+
+      struct node_type;
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * @brief Iterates the values of a version of the tree in ascending
+       * order, which remain valid as long as the version is referenced.
+       */
+      class const_iterator {
+
+        public:
+
+          using iterator_category = std::forward_iterator_tag;
+          using value_type        = T;
+          using difference_type   = std::ptrdiff_t;
+          using pointer           = const T*;
+          using reference         = const T&;
+
+          /**
+           * @brief Creates an iterator positioned on the smallest value
+           * of the given subtree, or an end iterator.
+           * @param node the root of the subtree.
+           */
+          explicit const_iterator(const node_type* node = nullptr) {
+            this->descend(node);
+          }
+
+          /**
+           * @return the value of the node currently iterated over.
+           */
+          const T& operator*() const {
+            return (this->stack.back()->data);
+          }
+
+          /**
+           * @return a pointer to the value of the node currently iterated over.
+           */
+          const T* operator->() const {
+            return (&this->stack.back()->data);
+          }
+
+          /**
+           * @brief Moves to the next value.
+           * @return a reference to the iterator.
+           */
+          const_iterator& operator++() {
+            auto node = this->stack.back();
+            this->stack.pop_back();
+            this->descend(node->right);
+            return (*this);
+          }
+
+          /**
+           * @brief Moves to the next value.
+           * @return a copy of the iterator before it was moved.
+           */
+          const_iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return (tmp);
+          }
+
+          bool operator==(const const_iterator& other) const {
+            return (this->stack == other.stack);
+          }
+
+          bool operator!=(const const_iterator& other) const {
+            return (!(*this == other));
+          }
+
+        private:
+
+          /**
+           * @brief Pushes the left spine of the given subtree.
+           */
+          void descend(const node_type* node) {
+            for (; node; node = node->left) {
+              this->stack.push_back(node);
+            }
+          }
+
+          // The ancestors of the current node whose value has not been visited.
+          std::vector<const node_type*> stack;
+      };
+
+      using iterator = const_iterator;
+
+      /**
+       * @brief Construct a new persistent binary-search tree object.
+       * @param options the options to associate to the tree.
+       */
+      explicit persistent_tree_t(const Options& options = Options()): options{options} {}
+
+      /**
+       * @brief Copy-constructor, sharing the nodes of `other`.
+       * @note Complexity is O(1).
+       */
+      persistent_tree_t(const persistent_tree_t& other):
+        root_{acquire(other.root_)}, size_of_tree{other.size_of_tree}, options{other.options} {}
+
+      /**
+       * @brief Move-constructor, taking over the nodes of `other`
+       * which is left empty.
+       * @note Does not throw unless copying the options does.
+       */
+      persistent_tree_t(persistent_tree_t&& other) noexcept(std::is_nothrow_copy_constructible_v<Options>):
+        root_{other.root_}, size_of_tree{other.size_of_tree}, options{other.options} {
+        other.root_ = nullptr;
+        other.size_of_tree = 0;
+      }
+
+      /**
+       * @brief Assignment operator, sharing the nodes of `other`.
+       * @note Complexity is O(1), besides destroying the nodes
+       * only referenced by the tree.
+       */
+      persistent_tree_t& operator=(const persistent_tree_t& other) {
+        auto root = acquire(other.root_);
+
+        release(this->root_);
+        this->root_        = root;
+        this->size_of_tree = other.size_of_tree;
+        this->options      = other.options;
+        return (*this);
+      }
+
+      /**
+       * @brief Move-assignment operator, taking over the nodes
+       * of `other` which is left empty.
+       * @note Does not throw unless copying the options does, in
+       * which case the tree is left untouched.
+       */
+      persistent_tree_t& operator=(persistent_tree_t&& other) noexcept(std::is_nothrow_copy_assignable_v<Options>) {
+        if (this != &other) {
+          this->options = other.options;
+          release(this->root_);
+          this->root_        = other.root_;
+          this->size_of_tree = other.size_of_tree;
+          other.root_        = nullptr;
+          other.size_of_tree = 0;
+        }
+        return (*this);
+      }
+
+      /**
+       * @brief Releases the nodes of the tree, destroying
+       * those that no other tree references.
+       */
+      ~persistent_tree_t() {
+        release(this->root_);
+      }
+
+      /**
+       * @return a tree sharing the current version of the tree, which
+       * later mutations of the tree leave untouched.
+       * @note Complexity is O(1).
+       */
+      persistent_tree_t snapshot() const {
+        return (*this);
+      }
+
+      /**
+       * @brief Inserts a set of values provided by the iterator in the tree.
+       * @param begin the iterator to the beginning of the values.
+       * @param end the iterator to the end of the values.
+       */
+      template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+      void insert(Iterator begin, Iterator end) {
+        for (Iterator it = begin; it != end; ++it) {
+          this->insert(*it);
+        }
+      }
+
+      /**
+       * @brief Inserts the given `data` in a new version of the tree.
+       * @param data the data to insert.
+       * @return whether the data was inserted, i.e no equal value was found.
+       * @note Complexity is O(log(n)), copying the nodes on the path
+       * from the root to the inserted node. The tree is left untouched
+       * if copying a value throws an exception.
+       */
+      bool insert(const T& data) {
+        if (this->contains(data)) {
+          return (false);
+        }
+        this->replace(this->insert(this->root_, data).release());
+        this->size_of_tree++;
+        return (true);
+      }
+
+      /**
+       * @brief Removes the value equal to the given `key` from
+       * a new version of the tree.
+       * @param key the key to look up.
+       * @return whether a value was removed.
+       * @note Complexity is O(log(n)), copying the nodes on the path
+       * from the root to the removed node. The tree is left untouched
+       * if copying a value throws an exception.
+       */
+      template <typename Key>
+      bool remove(const Key& key) {
+        if (!this->contains(key)) {
+          return (false);
+        }
+        this->replace(this->remove(this->root_, key).release());
+        this->size_of_tree--;
+        return (true);
+      }
+
+      /**
+       * @brief Clears the tree, destroying the nodes that
+       * no other tree references.
+       */
+      void clear() {
+        this->replace(nullptr);
+        this->size_of_tree = 0;
+      }
+
+      /**
+       * @brief Finds the value equal to the given `key`.
+       * @param key the key to look up.
+       * @return a pointer to the value, which remains valid as long as the
+       * current version is referenced, or NULL if no value is equal to the key.
+       * @note Complexity is O(log(n)).
+       */
+      template <typename Key>
+      const T* find(const Key& key) const {
+        for (auto node = this->root_; node;) {
+          auto result = this->options.compare(key, node->data);
+
+          if (!result) {
+            return (&node->data);
+          }
+          node = result < 0 ? node->left : node->right;
+        }
+        return (nullptr);
+      }
+
+      /**
+       * @return whether a value is equal to the given `key`.
+       * @note Complexity is O(log(n)).
+       */
+      template <typename Key>
+      bool contains(const Key& key) const {
+        return (this->find(key) != nullptr);
+      }
+
+      /**
+       * @return the number of values in the tree.
+       */
+      size_t size() const {
+        return (this->size_of_tree);
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->size_of_tree == 0);
+      }
+
+      /**
+       * @return the size and the height of the tree.
+       * @note Complexity is O(1).
+       */
+      tree_stats_t stats() const {
+        return {this->size_of_tree, (size_t) height(this->root_)};
+      }
+
+      /**
+       * @return whether both trees share the same version.
+       * @note Complexity is O(1).
+       */
+      bool shares(const persistent_tree_t& other) const {
+        return (this->root_ == other.root_);
+      }
+
+      /**
+       * @return an iterator to the smallest value of the tree.
+       */
+      const_iterator begin() const {
+        return (const_iterator(this->root_));
+      }
+
+      /**
+       * @return an iterator past the greatest value of the tree.
+       */
+      const_iterator end() const {
+        return (const_iterator());
+      }
+
+    private:
+
+      /**
+       * @brief An immutable node, referenced by its parents
+       * in the different versions of the tree.
+       */
+      struct node_type {
+        template <typename Value>
+        node_type(Value&& data, const node_type* left, const node_type* right):
+          data(std::forward<Value>(data)), left{left}, right{right},
+          height{1 + std::max(persistent_tree_t::height(left), persistent_tree_t::height(right))} {}
+
+        const T                     data;
+        const node_type*            left;
+        const node_type*            right;
+        const int                   height;
+        mutable std::atomic<size_t> references{1};
+      };
+
+      /**
+       * @return the height of the given subtree.
+       */
+      static int height(const node_type* node) {
+        return (node ? node->height : 0);
+      }
+
+      /**
+       * @brief Adds a reference to the given node.
+       * @return the node.
+       */
+      static const node_type* acquire(const node_type* node) {
+        if (node) {
+          node->references.fetch_add(1, std::memory_order_relaxed);
+        }
+        return (node);
+      }
+
+      /**
+       * @brief Removes a reference to the given node, destroying
+       * it along with its unreferenced descendants if it was the
+       * last one. The recursion is bound by the height of the tree.
+       */
+      static void release(const node_type* node) {
+        if (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          release(node->left);
+          release(node->right);
+          delete node;
+        }
+      }
+
+      /**
+       * @brief Makes the given root, which the tree owns a reference
+       * to, the current version of the tree.
+       */
+      void replace(const node_type* root) {
+        release(this->root_);
+        this->root_ = root;
+      }
+
+      /**
+       * @brief Releases the reference held to a node when the
+       * holder of the reference is destroyed.
+       */
+      struct releaser_t {
+        void operator()(const node_type* node) const {
+          release(node);
+        }
+      };
+
+      /**
+       * A reference to a node, released unless it is handed over,
+       * e.g when an exception is thrown while copying a path.
+       */
+      using reference_t = std::unique_ptr<const node_type, releaser_t>;
+
+      /**
+       * @brief Adds a reference to the given node.
+       * @return the reference.
+       */
+      static reference_t hold(const node_type* node) {
+        return (reference_t(acquire(node)));
+      }
+
+      /**
+       * @brief Creates a node holding the given `data`.
+       * @param data the data of the node.
+       * @param left the lower subtree, whose reference is taken over.
+       * @param right the upper subtree, whose reference is taken over.
+       * @return the reference to the node, the subtrees being
+       * released if the node cannot be created.
+       */
+      template <typename Value>
+      static reference_t make(Value&& data, reference_t left, reference_t right) {
+        auto node = new node_type(std::forward<Value>(data), left.get(), right.get());
+        left.release();
+        right.release();
+        return (reference_t(node));
+      }
+
+      /**
+       * @brief Creates a node holding the given `data`, rotating the
+       * given subtrees if their heights differ by more than one.
+       * @param data the data of the node.
+       * @param left the lower subtree, whose reference is taken over.
+       * @param right the upper subtree, whose reference is taken over.
+       * @return the reference to the root of the balanced subtree.
+       */
+      template <typename Value>
+      static reference_t balance(Value&& data, reference_t left, reference_t right) {
+        if (height(left.get()) > height(right.get()) + 1) {
+          if (height(left->left) >= height(left->right)) {
+            auto upper = make(std::forward<Value>(data), hold(left->right), std::move(right));
+            return (make(left->data, hold(left->left), std::move(upper)));
+          }
+          auto pivot = left->right;
+          auto upper = make(std::forward<Value>(data), hold(pivot->right), std::move(right));
+          auto lower = make(left->data, hold(left->left), hold(pivot->left));
+          return (make(pivot->data, std::move(lower), std::move(upper)));
+        }
+        if (height(right.get()) > height(left.get()) + 1) {
+          if (height(right->right) >= height(right->left)) {
+            auto lower = make(std::forward<Value>(data), std::move(left), hold(right->left));
+            return (make(right->data, std::move(lower), hold(right->right)));
+          }
+          auto pivot = right->left;
+          auto lower = make(std::forward<Value>(data), std::move(left), hold(pivot->left));
+          auto upper = make(right->data, hold(pivot->right), hold(right->right));
+          return (make(pivot->data, std::move(lower), std::move(upper)));
+        }
+        return (make(std::forward<Value>(data), std::move(left), std::move(right)));
+      }
+
+      /**
+       * @brief Copies the path from the given node to the position
+       * of `data`, which is not in the subtree.
+       * @return the reference to the root of the new subtree.
+       */
+      reference_t insert(const node_type* node, const T& data) {
+        if (!node) {
+          return (make(data, nullptr, nullptr));
+        }
+        if (this->options.compare(data, node->data) < 0) {
+          auto left = this->insert(node->left, data);
+          return (balance(node->data, std::move(left), hold(node->right)));
+        }
+        auto right = this->insert(node->right, data);
+        return (balance(node->data, hold(node->left), std::move(right)));
+      }
+
+      /**
+       * @brief Copies the path from the given node to the node equal to
+       * `key`, which is in the subtree, leaving the node out.
+       * @return the reference to the root of the new subtree.
+       */
+      template <typename Key>
+      reference_t remove(const node_type* node, const Key& key) {
+        auto result = this->options.compare(key, node->data);
+
+        if (result < 0) {
+          auto left = this->remove(node->left, key);
+          return (balance(node->data, std::move(left), hold(node->right)));
+        }
+        if (result > 0) {
+          auto right = this->remove(node->right, key);
+          return (balance(node->data, hold(node->left), std::move(right)));
+        }
+        if (!node->left || !node->right) {
+          return (hold(node->left ? node->left : node->right));
+        }
+
+        // The successor of the node takes its place.
+        auto successor = node->right;
+        while (successor->left) {
+          successor = successor->left;
+        }
+        auto right = this->remove(node->right, successor->data);
+        return (balance(successor->data, hold(node->left), std::move(right)));
+      }
+
+      const node_type* root_ = nullptr;
+      size_t           size_of_tree = 0;
+      Options          options;
+  };
+
+  /**
+   * @brief A binary-search tree partitioning its values across shards
+   * holding consecutive ranges of values, each shard being a `tree_t`
+   * guarded by its own lock, so that writers on different ranges
+   * do not contend with each other.
+   *
+   * Operations look up their shard in a table of split points, and check
+   * that the table did not change once the shard is locked. Rebalancing
+   * locks every shard, moves the split points to the quantiles of the
+   * values, and retires the former table through an epoch domain.
+   *
+   * @tparam T the type of the values stored in the tree, which must
+   * be copy-constructible.
+   * @tparam Balance the balancing policy of the shards.
+   * @tparam Options the options used to compare values.
+   */
+  template <typename T, typename Balance = red_black_t, typename Options = default_options_t<T>>
+  class sharded_tree_t {
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * The type of the shards.
+       */
+      using tree_type = tree_t<T, Balance, Options>;
+
+      /**
+       * @brief Construct a new sharded binary-search tree object.
+       * @param split_points the lowest value of every shard but the first
+       * one, the tree having one more shard than split points.
+       * @param options the options to associate to the shards.
+       * @param domain the domain reclaiming the tables of split points,
+       * which must outlive the tree.
+       * @throws std::invalid_argument if the split points are not
+       * sorted in strictly ascending order.
+       */
+      explicit sharded_tree_t(std::vector<T> split_points, const Options& options = Options(), epoch_domain_t& domain = default_epoch_domain()):
+        domain{domain}, options{options} {
+        for (size_t i = 1; i < split_points.size(); ++i) {
+          if (this->options.compare(split_points[i - 1], split_points[i]) >= 0) {
+            throw std::invalid_argument("split points must be sorted in strictly ascending order");
+          }
+        }
+        for (size_t i = 0; i <= split_points.size(); ++i) {
+          this->shards_.push_back(std::make_unique<shard_t>(options));
+        }
+        this->table.store(new std::vector<T>(std::move(split_points)), std::memory_order_release);
+      }
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      sharded_tree_t(const sharded_tree_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      sharded_tree_t& operator=(const sharded_tree_t&) = delete;
+
+      /**
+       * @brief Destroys the shards, which requires the
+       * other threads to be done with the tree.
+       */
+      ~sharded_tree_t() {
+        delete this->table.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Inserts the given `data` in its shard.
+       * @param data the data to insert.
+       * @return whether the data was inserted, i.e no equal value was found.
+       * @note Complexity is O(log(n)) on average in a balanced shard.
+       */
+      bool insert(const T& data) {
+        return (this->exclusive(data, [&] (tree_type& tree) { return (tree.insert(data) != nullptr); }));
+      }
+
+      /**
+       * @brief Moves the given `data` into its shard.
+       * @param data the data to move into the tree.
+       * @return whether the data was inserted, in which case it was moved.
+       * @note Complexity is O(log(n)) on average in a balanced shard.
+       */
+      bool insert(T&& data) {
+        return (this->exclusive(data, [&] (tree_type& tree) { return (tree.insert(std::move(data)) != nullptr); }));
+      }
+
+      /**
+       * @brief Removes the value equal to the given `data` from its shard.
+       * @param data the data to remove.
+       * @return whether a value was removed.
+       * @note Complexity is O(log(n)) on average in a balanced shard.
+       */
+      bool remove(const T& data) {
+        return (this->exclusive(data, [&] (tree_type& tree) {
+          auto size = tree.size();
+          tree.remove(data);
+          return (tree.size() != size);
+        }));
+      }
+
+      /**
+       * @brief Finds the value equal to the given `data`.
+       * @param data the data to look up.
+       * @return a copy of the value, or an empty optional
+       * if no value is equal to the data.
+       * @note Complexity is O(log(n)) on average in a balanced shard.
+       */
+      std::optional<T> find(const T& data) const {
+        return (this->shared(data, [&] (const tree_type& tree) -> std::optional<T> {
+          if (auto node = tree.find(data)) {
+            return ((*node)->value());
+          }
+          return {};
+        }));
+      }
+
+      /**
+       * @return whether a value is equal to the given `data`.
+       * @note Complexity is O(log(n)) on average in a balanced shard.
+       */
+      bool contains(const T& data) const {
+        return (this->shared(data, [&] (const tree_type& tree) { return (tree.find(data).has_value()); }));
+      }
+
+      /**
+       * @return the number of values in the tree.
+       * @note Complexity is O(s), `s` being the number of shards.
+       */
+      size_t size() const {
+        size_t size = 0;
+
+        for (auto size_of_shard : this->shard_sizes()) {
+          size += size_of_shard;
+        }
+        return (size);
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->size() == 0);
+      }
+
+      /**
+       * @return the number of values of every shard, in ascending order of
+       * their ranges, which lets callers detect the shards growing hot.
+       */
+      std::vector<size_t> shard_sizes() const {
+        std::vector<size_t> sizes;
+
+        for (auto& shard : this->shards_) {
+          std::shared_lock<std::shared_mutex> lock(shard->mutex);
+          sizes.push_back(shard->tree.size());
+        }
+        return (sizes);
+      }
+
+      /**
+       * @return a copy of the current split points.
+       */
+      std::vector<T> split_points() const {
+        auto guard = this->domain.pin();
+        return (*this->table.load(std::memory_order_acquire));
+      }
+
+      /**
+       * @brief Calls the given `callback` with the values of the tree in
+       * ascending order, as the concatenation of the ordered shards.
+       * @param callback the function called with every value.
+       * @note Every shard is locked for reading during the traversal,
+       * which sees a consistent state of the tree. Complexity is O(n).
+       */
+      template <typename Callback>
+      void for_each(Callback&& callback) const {
+        std::vector<std::shared_lock<std::shared_mutex>> locks;
+
+        for (auto& shard : this->shards_) {
+          locks.emplace_back(shard->mutex);
+        }
+        for (auto& shard : this->shards_) {
+          for (auto& value : shard->tree) {
+            callback(value);
+          }
+        }
+      }
+
+      /**
+       * @brief Moves the split points to the quantiles of the values if the
+       * largest shard holds more than `imbalance` times the average number
+       * of values per shard.
+       * @param imbalance the ratio between the size of the largest shard
+       * and the average size above which the shards are rebalanced.
+       * @return whether the shards were rebalanced.
+       * @note Every shard is locked during the rebalancing. The shards are
+       * joined in O(s.log(n)), and the quantiles are looked up and the
+       * shards split in O(n), `s` being the number of shards.
+       */
+      bool rebalance(double imbalance = 2) {
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+        size_t count = this->shards_.size();
+        size_t total = 0;
+        size_t largest = 0;
+
+        for (auto& shard : this->shards_) {
+          locks.emplace_back(shard->mutex);
+          total += shard->tree.size();
+          largest = std::max(largest, shard->tree.size());
+        }
+        if (count < 2 || total < count || largest <= imbalance * total / count) {
+          return (false);
+        }
+
+        // Joining the shards, which hold consecutive ranges.
+        auto tree = std::move(this->shards_[0]->tree);
+        for (size_t i = 1; i < count; ++i) {
+          tree.join(std::move(this->shards_[i]->tree));
+        }
+
+        // Splitting the values at their quantiles.
+        auto points = std::make_unique<std::vector<T>>();
+        size_t rank = 0;
+        for (auto it = tree.begin(); it != tree.end() && points->size() + 1 < count; ++it, ++rank) {
+          if (rank == (points->size() + 1) * total / count) {
+            points->push_back(*it);
+          }
+        }
+        for (size_t i = 0; i + 1 < count; ++i) {
+          auto [lower, upper] = tree.split((*points)[i]);
+          this->shards_[i]->tree = std::move(lower);
+          tree = std::move(upper);
+        }
+        this->shards_[count - 1]->tree = std::move(tree);
+
+        // Readers that looked up a shard in the former table retry once they lock it.
+        this->domain.retire(this->table.exchange(points.release(), std::memory_order_acq_rel));
+        return (true);
+      }
+
+    private:
+
+      /**
+       * @brief A shard of the tree, guarded by its own lock.
+       */
+      struct shard_t {
+        explicit shard_t(const Options& options): tree{options} {}
+
+        mutable std::shared_mutex mutex;
+        tree_type                 tree;
+      };
+
+      /**
+       * @return the index of the shard holding the given `data`
+       * according to the given split points.
+       */
+      size_t shard_of(const std::vector<T>& points, const T& data) const {
+        return (std::upper_bound(points.begin(), points.end(), data, [this] (const T& lhs, const T& rhs) {
+          return (this->options.compare(lhs, rhs) < 0);
+        }) - points.begin());
+      }
+
+      /**
+       * @brief Calls the given function with the tree of the shard of
+       * `data`, holding a lock of the given type on the shard.
+       * @return the result of the function.
+       */
+      template <typename Lock, typename Function>
+      auto locked(const T& data, Function&& function) const {
+        auto guard = this->domain.pin();
+
+        while (true) {
+          auto points = this->table.load(std::memory_order_acquire);
+          auto& shard = *this->shards_[this->shard_of(*points, data)];
+          Lock lock(shard.mutex);
+
+          // The split points cannot change while a shard is locked.
+          if (this->table.load(std::memory_order_acquire) == points) {
+            return (function(shard.tree));
+          }
+        }
+      }
+
+      /**
+       * @brief Calls the given function with the shard of `data`, locked for writing.
+       */
+      template <typename Function>
+      auto exclusive(const T& data, Function&& function) {
+        return (this->locked<std::unique_lock<std::shared_mutex>>(data, std::forward<Function>(function)));
+      }
+
+      /**
+       * @brief Calls the given function with the shard of `data`, locked for reading.
+       */
+      template <typename Function>
+      auto shared(const T& data, Function&& function) const {
+        return (this->locked<std::shared_lock<std::shared_mutex>>(data, std::forward<Function>(function)));
+      }
+
+      std::vector<std::unique_ptr<shard_t>> shards_;
+      std::atomic<std::vector<T>*>          table{nullptr};
+      epoch_domain_t&                       domain;
+      Options                               options;
+  };
+
+  /**
+   * @brief An immutable snapshot of a binary-search tree, storing its values
+   * in a single array in Eytzinger order, i.e the breadth-first order of
+   * a complete tree, in which the children of the `k`-th value are the
+   * `2k`-th and `2k + 1`-th values.
+   *
+   * Descents compute the index of the next value from the result of the
+   * comparison instead of branching on it, and prefetch the consecutive
+   * descendants of the current value a few levels below, so that look-ups
+   * neither chase pointers nor stall on mispredicted branches. The array
+   * starts on a cache line with a padding slot, so that these descendants
+   * share a single cache line when the size of the values is a power of two.
+   *
+   * @tparam T the type of the values stored in the tree, which must
+   * be copy-constructible.
+   * @tparam Options the options used to compare values.
+   * @tparam Prefetch whether descents prefetch the values a few levels
+   * below, which pays off once the array exceeds the caches.
+   */
+  template <typename T, typename Options, bool Prefetch>
+  class frozen_tree_t {
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * @brief Iterates the values of the tree in ascending order.
+       */
+      class const_iterator {
+
+        public:
+
+          using iterator_category = std::forward_iterator_tag;
+          using value_type        = T;
+          using difference_type   = std::ptrdiff_t;
+          using pointer           = const T*;
+          using reference         = const T&;
+
+          /**
+           * @brief Creates an iterator positioned on the value of the given
+           * Eytzinger index, or an end iterator if the index is 0.
+           * @param tree the iterated tree.
+           * @param index the 1-based index of the value.
+           */
+          const_iterator(const frozen_tree_t* tree = nullptr, size_t index = 0): tree{tree}, index{index} {}
+
+          /**
+           * @return the value currently iterated over.
+           */
+          const T& operator*() const {
+            return (this->tree->values[this->index]);
+          }
+
+          /**
+           * @return a pointer to the value currently iterated over.
+           */
+          const T* operator->() const {
+            return (&this->tree->values[this->index]);
+          }
+
+          /**
+           * @brief Moves to the next value, i.e the leftmost value of the right
+           * subtree, or the first ancestor whose left subtree holds the value.
+           * @return a reference to the iterator.
+           */
+          const_iterator& operator++() {
+            size_t size = this->tree->size();
+
+            if (2 * this->index + 1 <= size) {
+              this->index = leftmost(2 * this->index + 1, size);
+            } else {
+              this->index = climb(this->index);
+            }
+            return (*this);
+          }
+
+          /**
+           * @brief Moves to the next value.
+           * @return a copy of the iterator before it was moved.
+           */
+          const_iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return (tmp);
+          }
+
+          bool operator==(const const_iterator& other) const {
+            return (this->index == other.index);
+          }
+
+          bool operator!=(const const_iterator& other) const {
+            return (!(*this == other));
+          }
+
+        private:
+          const frozen_tree_t* tree;
+          size_t index;
+      };
+
+      using iterator = const_iterator;
+
+      /**
+       * @brief Construct a new frozen tree holding the given values.
+       * @param begin the iterator to the beginning of the values.
+       * @param end the iterator to the end of the values.
+       * @param options the options used to compare values.
+       * @note Values must be sorted and unique. Complexity is O(n).
+       */
+      template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+      frozen_tree_t(Iterator begin, Iterator end, const Options& options = Options()): options{options} {
+        std::vector<T> sorted(begin, end);
+        std::vector<size_t> ranks(sorted.size());
+        size_t rank = 0;
+
+        // Assigning ranks to the Eytzinger indices with an in-order walk.
+        this->assign(ranks, 1, rank);
+        if (sorted.empty()) {
+          return;
+        }
+
+        // The padding slot holds a copy of a value, as values
+        // may not be default-constructible.
+        this->values.reserve(sorted.size() + 1);
+        this->values.push_back(sorted.front());
+        for (auto r : ranks) {
+          this->values.push_back(std::move(sorted[r]));
+        }
+      }
+
+      /**
+       * @brief Finds the smallest value which is not less than the given `key`.
+       * @param key the key to look up.
+       * @return an iterator to the value, or an end iterator if
+       * all the values are less than the key.
+       * @note Complexity is O(log(n)).
+       */
+      template <typename Key>
+      const_iterator lower_bound(const Key& key) const {
+        return (const_iterator(this, this->search(key)));
+      }
+
+      /**
+       * @brief Finds the value equal to the given `key`.
+       * @param key the key to look up.
+       * @return a pointer to the value, or NULL if no value is equal to the key.
+       * @note Complexity is O(log(n)).
+       */
+      template <typename Key>
+      const T* find(const Key& key) const {
+        auto index = this->search(key);
+
+        if (index && this->options.compare(key, this->values[index]) == 0) {
+          return (&this->values[index]);
+        }
+        return (nullptr);
+      }
+
+      /**
+       * @return whether a value is equal to the given `key`.
+       * @note Complexity is O(log(n)).
+       */
+      template <typename Key>
+      bool contains(const Key& key) const {
+        return (this->find(key) != nullptr);
+      }
+
+      /**
+       * @return the number of values in the tree.
+       */
+      size_t size() const {
+        return (this->values.empty() ? 0 : this->values.size() - 1);
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->values.empty());
+      }
+
+      /**
+       * @return an iterator to the smallest value of the tree.
+       */
+      const_iterator begin() const {
+        return (const_iterator(this, this->values.empty() ? 0 : leftmost(1, this->size())));
+      }
+
+      /**
+       * @return an iterator past the greatest value of the tree.
+       */
+      const_iterator end() const {
+        return (const_iterator(this));
+      }
+
+    private:
+
+      /**
+       * The size of the cache lines the array is aligned on.
+       */
+      static constexpr size_t cache_line = 64;
+
+      /**
+       * @brief A standard-compatible allocator aligning
+       * the storage it allocates on a cache line.
+       */
+      template <typename U>
+      struct aligned_allocator_t {
+        using value_type = U;
+
+        template <typename V>
+        struct rebind {
+          using other = aligned_allocator_t<V>;
+        };
+
+        aligned_allocator_t() = default;
+
+        template <typename V>
+        aligned_allocator_t(const aligned_allocator_t<V>&) {}
+
+        U* allocate(size_t n) {
+          return (static_cast<U*>(::operator new(n * sizeof(U), std::align_val_t(cache_line))));
+        }
+
+        void deallocate(U* ptr, size_t) {
+          ::operator delete(ptr, std::align_val_t(cache_line));
+        }
+
+        template <typename V>
+        bool operator==(const aligned_allocator_t<V>&) const {
+          return (true);
+        }
+
+        template <typename V>
+        bool operator!=(const aligned_allocator_t<V>&) const {
+          return (false);
+        }
+      };
+
+      /**
+       * The number of consecutive indices prefetched ahead of a descent,
+       * i.e the number of values fitting in a cache line, rounded down
+       * to a power of two so that they are the descendants of a single
+       * value a few levels below.
+       */
+      static constexpr size_t prefetched = sizeof(T) > 32 ? 1 : sizeof(T) > 16 ? 2 : sizeof(T) > 8 ? 4 : sizeof(T) > 4 ? 8 : 16;
+
+      /**
+       * @return the given index shifted right past its trailing 1-bits,
+       * and past the 0-bit preceding them.
+       */
+      static size_t climb(size_t index) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (index >> (__builtin_ctzll(~static_cast<unsigned long long>(index)) + 1));
+#else
+        while (index & 1) {
+          index >>= 1;
+        }
+        return (index >> 1);
+#endif
+      }
+
+      /**
+       * @return the index of the leftmost value of the subtree of the given index.
+       */
+      static size_t leftmost(size_t index, size_t size) {
+        while (2 * index <= size) {
+          index *= 2;
+        }
+        return (index);
+      }
+
+      /**
+       * @brief Recursively assigns the given rank, and the following ranks,
+       * to the subtree of the given index in in-order.
+       */
+      void assign(std::vector<size_t>& ranks, size_t index, size_t& rank) {
+        if (index <= ranks.size()) {
+          this->assign(ranks, 2 * index, rank);
+          ranks[index - 1] = rank++;
+          this->assign(ranks, 2 * index + 1, rank);
+        }
+      }
+
+      /**
+       * @return the 1-based index of the smallest value not less
+       * than the given key, or 0 if there is no such value.
+       */
+      template <typename Key>
+      size_t search(const Key& key) const {
+        size_t size = this->size();
+        size_t index = 1;
+
+        while (index <= size) {
+#if defined(__GNUC__) || defined(__clang__)
+          // The descendants `log2(prefetched)` levels below start at a multiple
+          // of `prefetched`, i.e at the beginning of a cache line.
+          if (Prefetch && prefetched > 1 && prefetched * index <= size) {
+            __builtin_prefetch(&this->values[prefetched * index]);
+          }
+#endif
+          // Going right when the value is less than the key, without branching.
+          index = 2 * index + (this->options.compare(this->values[index], key) < 0);
+        }
+        // Going back up to the last value from which the descent went left.
+        return (climb(index));
+      }
+
+      // The values in Eytzinger order, preceded by a padding slot so
+      // that the `k`-th value is stored at index `k`.
+      std::vector<T, aligned_allocator_t<T>> values;
+      Options                                options;
+  };
+
+  /**
+   * @brief A static B-tree indexing sorted integers, whose nodes hold
+   * 16 keys compared at once with SIMD instructions.
+   *
+   * Nodes are aligned on cache lines and stored in a single array, the
+   * `i`-th child of the `k`-th node being the `k * 17 + i + 1`-th node, so
+   * that a look-up visits a single node per level of a tree of height
+   * log17(n), counting the keys of the node less than the searched key
+   * to select the child to descend into.
+   *
+   * The instructions are selected at runtime: AVX2 when the processor
+   * supports it, otherwise SSE2 for 32-bit integers on x86, or a
+   * portable loop.
+   *
+   * @tparam T the type of the indexed integers, either `int32_t` or `int64_t`,
+   * ordered by their `<` operator.
+   */
+  template <typename T>
+  class static_btree_t {
+
+      static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>, "static_btree_t indexes 32-bit or 64-bit integers");
+
+    public:
+
+      /**
+       * The type of the values stored in the index.
+       */
+      using value_type = T;
+
+      /**
+       * The number of keys held by a node.
+       */
+      static constexpr size_t keys_per_node = 16;
+
+      /**
+       * @brief Construct a new index holding the given values.
+       * @param begin the iterator to the beginning of the values.
+       * @param end the iterator to the end of the values.
+       * @note Values must be sorted and unique, such as the values of a
+       * `tree_t` iterated in order. Complexity is O(n).
+       */
+      template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+      static_btree_t(Iterator begin, Iterator end): search{select()} {
+        std::vector<T> sorted(begin, end);
+        size_t next = 0;
+
+        this->size_of_index = sorted.size();
+        this->has_max = !sorted.empty() && sorted.back() == std::numeric_limits<T>::max();
+        this->nodes.resize((sorted.size() + keys_per_node - 1) / keys_per_node);
+        this->assign(sorted, 0, next);
+      }
+
+      /**
+       * @brief Finds the smallest value which is not less than the given `key`.
+       * @param key the key to look up.
+       * @return a pointer to the value, or NULL if all the
+       * values are less than the key.
+       * @note Complexity is O(log(n)).
+       */
+      const T* lower_bound(T key) const {
+        auto value = (this->*search)(key);
+
+        // Padding keys are greater than the indexed values.
+        if (value && *value == std::numeric_limits<T>::max() && !this->has_max) {
+          return (nullptr);
+        }
+        return (value);
+      }
+
+      /**
+       * @brief Finds the value equal to the given `key`.
+       * @param key the key to look up.
+       * @return a pointer to the value, or NULL if no value is equal to the key.
+       * @note Complexity is O(log(n)).
+       */
+      const T* find(T key) const {
+        auto value = this->lower_bound(key);
+        return (value && *value == key ? value : nullptr);
+      }
+
+      /**
+       * @return whether a value is equal to the given `key`.
+       * @note Complexity is O(log(n)).
+       */
+      bool contains(T key) const {
+        return (this->find(key) != nullptr);
+      }
+
+      /**
+       * @return the number of values in the index.
+       */
+      size_t size() const {
+        return (this->size_of_index);
+      }
+
+      /**
+       * @return whether the index is empty.
+       */
+      bool empty() const {
+        return (this->size_of_index == 0);
+      }
+
+      /**
+       * @return the name of the instructions used to compare keys,
+       * i.e "avx2", "sse2" or "scalar".
+       */
+      static const char* instruction_set() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        auto search = select();
+
+        if (search == &static_btree_t::search_avx2) {
+          return ("avx2");
+        }
+        if constexpr (std::is_same_v<T, int32_t>) {
+          if (search == &static_btree_t::search_sse2) {
+            return ("sse2");
+          }
+        }
+#endif
+        return ("scalar");
+      }
+
+    private:
+
+      /**
+       * @brief A node, filling whole cache lines.
+       */
+      struct alignas(64) node_type {
+        T keys[keys_per_node];
+      };
+
+      /**
+       * The type of the functions returning the lower bound of a key.
+       */
+      using search_t = const T* (static_btree_t::*)(T) const;
+
+      /**
+       * @return the index of the `i`-th child of the `k`-th node.
+       */
+      static size_t child(size_t k, size_t i) {
+        return (k * (keys_per_node + 1) + i + 1);
+      }
+
+      /**
+       * @brief Recursively assigns the given values, from `next` onwards,
+       * to the subtree of the `k`-th node in in-order, padding the nodes
+       * left past the last value with the greatest integer.
+       */
+      void assign(const std::vector<T>& sorted, size_t k, size_t& next) {
+        if (k >= this->nodes.size()) {
+          return;
+        }
+        for (size_t i = 0; i < keys_per_node; ++i) {
+          this->assign(sorted, child(k, i), next);
+          this->nodes[k].keys[i] = next < sorted.size() ? sorted[next++] : std::numeric_limits<T>::max();
+        }
+        this->assign(sorted, child(k, keys_per_node), next);
+      }
+
+      /**
+       * @brief Descends the tree, selecting the child of every node
+       * with the given function counting the keys less than `key`.
+       * @return a pointer to the smallest key not less than `key`,
+       * or NULL if there is no such key.
+       * @note Inlined in the search functions, so that the counting
+       * function is inlined with the instructions they target.
+       */
+      template <size_t (*Rank)(const T*, T)>
+      [[gnu::always_inline]] const T* descend(T key) const {
+        const T* value = nullptr;
+
+        for (size_t k = 0; k < this->nodes.size();) {
+          auto keys = this->nodes[k].keys;
+          auto i = Rank(keys, key);
+
+          if (i < keys_per_node) {
+            value = keys + i;
+          }
+          k = child(k, i);
+        }
+        return (value);
+      }
+
+      /**
+       * @return the number of the given keys less than `key`.
+       */
+      static size_t rank_scalar(const T* keys, T key) {
+        size_t count = 0;
+
+        for (size_t i = 0; i < keys_per_node; ++i) {
+          count += keys[i] < key;
+        }
+        return (count);
+      }
+
+      /**
+       * @return the lower bound of `key`, comparing keys with the portable loop.
+       */
+      const T* search_scalar(T key) const {
+        return (this->descend<rank_scalar>(key));
+      }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+      /**
+       * @return the number of the given keys less than `key`,
+       * comparing 4 keys per instruction.
+       */
+      [[gnu::target("sse2")]] static size_t rank_sse2(const T* keys, T key) {
+        auto x = _mm_set1_epi32(key);
+        unsigned mask = 0;
+
+        for (size_t i = 0; i < keys_per_node; i += 4) {
+          auto lower = _mm_cmpgt_epi32(x, _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i)));
+          mask |= (unsigned) _mm_movemask_ps(_mm_castsi128_ps(lower)) << i;
+        }
+        return (__builtin_popcount(mask));
+      }
+
+      /**
+       * @return the lower bound of `key`, comparing keys with SSE2 instructions.
+       */
+      [[gnu::target("sse2")]] const T* search_sse2(T key) const {
+        return (this->descend<rank_sse2>(key));
+      }
+
+      /**
+       * @return the number of the given keys less than `key`,
+       * comparing 8 32-bit or 4 64-bit keys per instruction.
+       */
+      [[gnu::target("avx2")]] static size_t rank_avx2(const T* keys, T key) {
+        unsigned mask = 0;
+
+        if constexpr (std::is_same_v<T, int32_t>) {
+          auto x = _mm256_set1_epi32(key);
+
+          for (size_t i = 0; i < keys_per_node; i += 8) {
+            auto lower = _mm256_cmpgt_epi32(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i)));
+            mask |= (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(lower)) << i;
+          }
+        } else {
+          auto x = _mm256_set1_epi64x(key);
+
+          for (size_t i = 0; i < keys_per_node; i += 4) {
+            auto lower = _mm256_cmpgt_epi64(x, _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i)));
+            mask |= (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(lower)) << i;
+          }
+        }
+        return (__builtin_popcount(mask));
+      }
+
+      /**
+       * @return the lower bound of `key`, comparing keys with AVX2 instructions.
+       */
+      [[gnu::target("avx2")]] const T* search_avx2(T key) const {
+        return (this->descend<rank_avx2>(key));
+      }
+#endif
+
+      /**
+       * @return the fastest search function supported by the processor.
+       */
+      static search_t select() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        if (__builtin_cpu_supports("avx2")) {
+          return (&static_btree_t::search_avx2);
+        }
+        if constexpr (std::is_same_v<T, int32_t>) {
+          if (__builtin_cpu_supports("sse2")) {
+            return (&static_btree_t::search_sse2);
+          }
+        }
+#endif
+        return (&static_btree_t::search_scalar);
+      }
+
+      std::vector<node_type> nodes;
+      size_t                 size_of_index = 0;
+      bool                   has_max = false;
+      search_t               search;
+  };
+
+  /**
+   * @brief An in-memory B+tree, storing its values in leaves of up to
+   * `Capacity` values linked in ascending order, under inner nodes routing
+   * look-ups with up to `Capacity` separator keys.
+   *
+   * Nodes span a few cache lines instead of holding a single value, so that
+   * a look-up visits log_Capacity(n) nodes, and iterations scan contiguous
+   * values. The tree exposes the same `insert`, `remove`, `find`, `min`,
+   * `max`, `begin` and `end` operations as `tree_t`, so that both engines
+   * can be swapped with a type alias.
+   *
+   * @tparam T the type of the values stored in the tree, which must be
+   * copy-constructible and nothrow move-constructible.
+   * @tparam Options the options used to compare values.
+   * @tparam Capacity the maximum number of values of a leaf, and of keys of
+   * an inner node, filling 4 cache lines by default.
+   * @note Unlike with `tree_t`, values move between leaves when the tree is
+   * mutated, so pointers to values and iterators are invalidated by
+   * insertions and removals.
+   */
+  template <typename T, typename Options = default_options_t<T>, size_t Capacity = std::max<size_t>(8, 256 / sizeof(T))>
+  class btree_t {
+
+      static_assert(Capacity >= 4, "B+tree nodes must hold at least 4 keys");
+      static_assert(std::is_nothrow_move_constructible_v<T>, "B+tree values must be nothrow move-constructible");
+
+      struct leaf_type;
+
+    public:
+
+      /**
+       * The type of the values stored in the tree.
+       */
+      using value_type = T;
+
+      /**
+       * @brief A value stored in a leaf, exposing the same
+       * accessor as the nodes of `tree_t`.
+       */
+      struct node_type {
+        T data;
+
+        /**
+         * @return a reference to the value.
+         */
+        const T& value() const {
+          return (this->data);
+        }
+      };
+
+      /**
+       * @brief Iterates the values of the tree in ascending order,
+       * following the links between the leaves.
+       */
+      class const_iterator {
+
+        public:
+
+          using iterator_category = std::forward_iterator_tag;
+          using value_type        = T;
+          using difference_type   = std::ptrdiff_t;
+          using pointer           = const T*;
+          using reference         = const T&;
+
+          /**
+           * @brief Creates an iterator positioned on the given value
+           * of the given leaf, or an end iterator.
+           * @param leaf the leaf holding the value.
+           * @param index the index of the value in the leaf.
+           */
+          const_iterator(const leaf_type* leaf = nullptr, size_t index = 0): leaf{leaf}, index{index} {}
+
+          /**
+           * @return the value currently iterated over.
+           */
+          const T& operator*() const {
+            return (this->leaf->values[this->index].data);
+          }
+
+          /**
+           * @return a pointer to the value currently iterated over.
+           */
+          const T* operator->() const {
+            return (&this->leaf->values[this->index].data);
+          }
+
+          /**
+           * @brief Moves to the next value.
+           * @return a reference to the iterator.
+           */
+          const_iterator& operator++() {
+            if (++this->index == this->leaf->count) {
+              this->leaf  = this->leaf->next;
+              this->index = 0;
+            }
+            return (*this);
+          }
+
+          /**
+           * @brief Moves to the next value.
+           * @return a copy of the iterator before it was moved.
+           */
+          const_iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return (tmp);
+          }
+
+          bool operator==(const const_iterator& other) const {
+            return (this->leaf == other.leaf && this->index == other.index);
+          }
+
+          bool operator!=(const const_iterator& other) const {
+            return (!(*this == other));
+          }
+
+        private:
+          const leaf_type* leaf;
+          size_t index;
+      };
+
+      using iterator = const_iterator;
+
+      /**
+       * @brief Construct a new B+tree object.
+       * @param options the options to associate to the tree.
+       */
+      explicit btree_t(const Options& options = Options()): options{options} {}
+
+      /**
+       * Copy-constructor is deleted.
+       */
+      btree_t(const btree_t&) = delete;
+
+      /**
+       * Assignment operator is deleted.
+       */
+      btree_t& operator=(const btree_t&) = delete;
+
+      /**
+       * @brief Move-constructor, taking over the nodes of `other`
+       * which is left empty.
+       * @note Does not throw unless copying the options does.
+       */
+      btree_t(btree_t&& other) noexcept(std::is_nothrow_copy_constructible_v<Options>):
+        root_{other.root_}, head{other.head}, tail{other.tail}, size_of_tree{other.size_of_tree}, height{other.height}, options{other.options} {
+        other.root_ = other.head = other.tail = nullptr;
+        other.size_of_tree = other.height = 0;
+      }
+
+      /**
+       * @brief Move-assignment operator, clearing the tree and taking
+       * over the nodes of `other` which is left empty.
+       * @note Does not throw unless copying the options does.
+       */
+      btree_t& operator=(btree_t&& other) noexcept(std::is_nothrow_copy_assignable_v<Options>) {
+        if (this != &other) {
+          this->clear();
+          this->root_        = other.root_;
+          this->head         = other.head;
+          this->tail         = other.tail;
+          this->size_of_tree = other.size_of_tree;
+          this->height       = other.height;
+          this->options      = other.options;
+          other.root_ = other.head = other.tail = nullptr;
+          other.size_of_tree = other.height = 0;
+        }
+        return (*this);
+      }
+
+      /**
+       * @brief B+tree destructor.
+       */
+      ~btree_t() {
+        this->clear();
+      }
+
+      /**
+       * @brief Inserts a set of values provided by the iterator in the tree.
+       * @param begin the iterator to the beginning of the values.
+       * @param end the iterator to the end of the values.
+       */
+      template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+      void insert(Iterator begin, Iterator end) {
+        for (Iterator it = begin; it != end; ++it) {
+          this->insert(*it);
+        }
+      }
+
+      /**
+       * @brief Inserts the given `data` in the tree.
+       * @param data the data to insert.
+       * @return a pointer to the inserted value, or NULL if an equal
+       * value already exists.
+       * @note Complexity is O(log(n)).
+       */
+      const node_type* insert(const T& data) {
+        return (this->emplace(data));
+      }
+
+      /**
+       * @brief Moves the given `data` into the tree.
+       * @param data the data to move into the tree.
+       * @return a pointer to the inserted value, or NULL if an equal
+       * value already exists, in which case the data is not moved.
+       * @note Complexity is O(log(n)).
+       */
+      const node_type* insert(T&& data) {
+        return (this->emplace(std::move(data)));
+      }
+
+      /**
+       * @brief Removes a set of values provided by the iterator from the tree.
+       * @param begin the iterator to the beginning of the values.
+       * @param end the iterator to the end of the values.
+       */
+      template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+      void remove(Iterator begin, Iterator end) {
+        for (Iterator it = begin; it != end; ++it) {
+          this->remove(*it);
+        }
+      }
+
+      /**
+       * @brief Removes the value equal to the given `data` from the tree,
+       * borrowing values from, or merging with, the siblings of the nodes
+       * left less than half full.
+       * @param data the data to remove from the tree.
+       * @note Complexity is O(log(n)).
+       */
+      void remove(const T& data) {
+        path_t path;
+        size_t depth = 0;
+        auto leaf = this->descend(data, path, depth);
+
+        if (!leaf) {
+          return;
+        }
+        auto index = lower_bound(*leaf, data, this->options);
+        if (index == leaf->count || this->options.compare(data, leaf->values[index].data) != 0) {
+          return;
+        }
+        erase(leaf->values, leaf->count, index);
+        this->size_of_tree--;
+
+        // Restoring the occupancy of the nodes, from the leaf up to the root.
+        node_base_t* node = leaf;
+        for (; depth > 0 && node->count < min_count; --depth) {
+          auto [parent, index] = path[depth - 1];
+          this->underflow(parent, index, depth + 1 == this->height);
+          node = parent;
+        }
+        this->shrink();
+      }
+
+      /**
+       * @brief Finds the value equal to the given `data`.
+       * @param data the data to look up.
+       * @return an optional pointer to the value.
+       * @note Complexity is O(log(n)).
+       */
+      std::optional<const node_type*> find(const T& data) const {
+        const node_base_t* node = this->root_;
+
+        if (!node) {
+          return {};
+        }
+        for (size_t depth = 1; depth < this->height; ++depth) {
+          auto inner = static_cast<const inner_type*>(node);
+          node = inner->children[child_of(*inner, data, this->options)];
+        }
+        auto leaf = static_cast<const leaf_type*>(node);
+        auto index = lower_bound(*leaf, data, this->options);
+
+        if (index < leaf->count && this->options.compare(data, leaf->values[index].data) == 0) {
+          return (&leaf->values[index]);
+        }
+        return {};
+      }
+
+      /**
+       * @return a pointer to the smallest value, or NULL if the tree is empty.
+       * @note Complexity is O(1).
+       */
+      const node_type* min() const {
+        return (this->head ? &this->head->values[0] : nullptr);
+      }
+
+      /**
+       * @return a pointer to the greatest value, or NULL if the tree is empty.
+       * @note Complexity is O(1).
+       */
+      const node_type* max() const {
+        return (this->tail ? &this->tail->values[this->tail->count - 1] : nullptr);
+      }
+
+      /**
+       * @return the number of values in the tree.
+       */
+      size_t size() const {
+        return (this->size_of_tree);
+      }
+
+      /**
+       * @return whether the tree is empty.
+       */
+      bool empty() const {
+        return (this->size_of_tree == 0);
+      }
+
+      /**
+       * @return the number of values and the number of levels of the tree.
+       * @note Complexity is O(1).
+       */
+      tree_stats_t stats() const {
+        return {this->size_of_tree, this->height};
+      }
+
+      /**
+       * @brief Clears the tree.
+       * @note Complexity is O(n).
+       */
+      void clear() {
+        destroy(this->root_, this->height);
+        this->root_ = this->head = this->tail = nullptr;
+        this->size_of_tree = this->height = 0;
+      }
+
+      /**
+       * @return an iterator to the smallest value of the tree.
+       */
+      const_iterator begin() const {
+        return (const_iterator(this->head));
+      }
+
+      /**
+       * @return an iterator past the greatest value of the tree.
+       */
+      const_iterator end() const {
+        return (const_iterator());
+      }
+
+    private:
+
+      /**
+       * The minimal number of values of a leaf, and of keys of
+       * an inner node, besides the root.
+       */
+      static constexpr size_t min_count = Capacity / 2;
+
+      /**
+       * @brief Uninitialized storage for the elements of a node, with room
+       * for an element past the capacity, inserted before the node is split.
+       */
+      template <typename U>
+      struct slots_t {
+        union slot_t {
+          slot_t() {}
+          ~slot_t() {}
+          U value;
+        };
+
+        slot_t slots[Capacity + 1];
+
+        U& operator[](size_t i) {
+          return (this->slots[i].value);
+        }
+
+        const U& operator[](size_t i) const {
+          return (this->slots[i].value);
+        }
+      };
+
+      /**
+       * @brief The header shared by leaves and inner nodes.
+       */
+      struct node_base_t {
+        size_t count = 0;
+      };
+
+      /**
+       * @brief A leaf, holding values in ascending order.
+       */
+      struct leaf_type : node_base_t {
+        leaf_type*         prev = nullptr;
+        leaf_type*         next = nullptr;
+        slots_t<node_type> values;
+      };
+
+      /**
+       * @brief An inner node, whose `i`-th key is the smallest value
+       * of its `i + 1`-th child when it was inserted.
+       */
+      struct inner_type : node_base_t {
+        slots_t<T>   keys;
+        node_base_t* children[Capacity + 2];
+      };
+
+      /**
+       * The inner nodes visited by a descent, with the index of the child
+       * followed in every one of them. Nodes holding at least 2 children,
+       * 64 levels hold any tree.
+       */
+      using path_t = std::array<std::pair<inner_type*, size_t>, 64>;
+
+      /**
+       * @brief Constructs a new element at the given index of the given
+       * elements, shifting the following elements to the right.
+       */
+      template <typename U, typename... Args>
+      static void emplace_at(slots_t<U>& slots, size_t count, size_t index, Args&&... args) {
+        U value(std::forward<Args>(args)...);
+
+        for (size_t i = count; i > index; --i) {
+          new (&slots[i]) U(std::move(slots[i - 1]));
+          slots[i - 1].~U();
+        }
+        new (&slots[index]) U(std::move(value));
+      }
+
+      /**
+       * @brief Destroys the element at the given index of the given
+       * elements, shifting the following elements to the left.
+       */
+      template <typename U>
+      static void erase(slots_t<U>& slots, size_t& count, size_t index) {
+        slots[index].~U();
+        for (size_t i = index + 1; i < count; ++i) {
+          new (&slots[i - 1]) U(std::move(slots[i]));
+          slots[i].~U();
+        }
+        count--;
+      }
+
+      /**
+       * @brief Moves `n` elements from the given index of `from` to the
+       * given index of `to`, which must not be constructed.
+       */
+      template <typename U>
+      static void relocate(slots_t<U>& from, size_t index, size_t n, slots_t<U>& to, size_t at) {
+        for (size_t i = 0; i < n; ++i) {
+          new (&to[at + i]) U(std::move(from[index + i]));
+          from[index + i].~U();
+        }
+      }
+
+      /**
+       * @brief Replaces the given key by a copy of the given value.
+       */
+      static void assign(T& key, const T& value) {
+        T copy(value);
+
+        key.~T();
+        new (&key) T(std::move(copy));
+      }
+
+      /**
+       * @return the index of the first of the `count` elements
+       * for which the given predicate does not hold.
+       */
+      template <typename Predicate>
+      static size_t partition_point(size_t count, Predicate&& before) {
+        size_t first = 0;
+
+        while (count > 0) {
+          size_t half = count / 2;
+
+          if (before(first + half)) {
+            first += half + 1;
+            count -= half + 1;
+          } else {
+            count = half;
+          }
+        }
+        return (first);
+      }
+
+      /**
+       * @return the index of the first value of the leaf not less than `data`.
+       */
+      static size_t lower_bound(const leaf_type& leaf, const T& data, const Options& options) {
+        return (partition_point(leaf.count, [&] (size_t i) {
+          return (options.compare(leaf.values[i].data, data) < 0);
+        }));
+      }
+
+      /**
+       * @return the index of the child of the inner node leading to `data`.
+       */
+      static size_t child_of(const inner_type& inner, const T& data, const Options& options) {
+        return (partition_point(inner.count, [&] (size_t i) {
+          return (options.compare(inner.keys[i], data) <= 0);
+        }));
+      }
+
+      /**
+       * @brief Descends to the leaf which may hold `data`, recording
+       * the visited inner nodes in the given path.
+       * @return the leaf, or NULL if the tree is empty.
+       */
+      leaf_type* descend(const T& data, path_t& path, size_t& depth) {
+        node_base_t* node = this->root_;
+
+        for (depth = 0; node && depth + 1 < this->height; ++depth) {
+          auto inner = static_cast<inner_type*>(node);
+          auto index = child_of(*inner, data, this->options);
+
+          path[depth] = {inner, index};
+          node = inner->children[index];
+        }
+        return (static_cast<leaf_type*>(node));
+      }
+
+      /**
+       * @brief Inserts a value constructed from the given arguments,
+       * splitting the nodes overflowing from the leaf up to the root.
+       * @return a pointer to the inserted value, or NULL if an equal
+       * value already exists.
+       */
+      template <typename Value>
+      const node_type* emplace(Value&& data) {
+        path_t path;
+        size_t depth = 0;
+
+        if (!this->root_) {
+          this->root_ = this->head = this->tail = new leaf_type();
+          this->height = 1;
+        }
+        auto leaf = this->descend(data, path, depth);
+        auto index = lower_bound(*leaf, data, this->options);
+
+        if (index < leaf->count && this->options.compare(data, leaf->values[index].data) == 0) {
+          return (nullptr);
+        }
+        emplace_at(leaf->values, leaf->count++, index, node_type{std::forward<Value>(data)});
+        this->size_of_tree++;
+        if (leaf->count <= Capacity) {
+          return (&leaf->values[index]);
+        }
+
+        // Splitting the leaf, and moving its upper half to a new leaf.
+        auto right = new leaf_type();
+        size_t half = leaf->count / 2;
+
+        relocate(leaf->values, half, leaf->count - half, right->values, 0);
+        right->count = leaf->count - half;
+        leaf->count  = half;
+        right->prev  = leaf;
+        right->next  = leaf->next;
+        (leaf->next ? leaf->next->prev : this->tail) = right;
+        leaf->next   = right;
+
+        const node_type* inserted = index < half ? &leaf->values[index] : &right->values[index - half];
+        this->propagate(path, depth, right, right->values[0].data);
+        return (inserted);
+      }
+
+      /**
+       * @brief Inserts the given separator and the given new right child
+       * in the parents of a split node, splitting them in turn if
+       * they overflow, and growing a new root if the root was split.
+       */
+      void propagate(path_t& path, size_t depth, node_base_t* right, const T& first) {
+        std::optional<T> separator(first);
+
+        for (; depth > 0; --depth) {
+          auto [parent, index] = path[depth - 1];
+
+          emplace_at(parent->keys, parent->count, index, std::move(*separator));
+          std::copy_backward(parent->children + index + 1, parent->children + parent->count + 1, parent->children + parent->count + 2);
+          parent->children[index + 1] = right;
+          if (++parent->count <= Capacity) {
+            return;
+          }
+
+          // Splitting the inner node, whose middle key moves up.
+          auto sibling = new inner_type();
+          size_t middle = parent->count / 2;
+
+          separator.emplace(std::move(parent->keys[middle]));
+          parent->keys[middle].~T();
+          relocate(parent->keys, middle + 1, parent->count - middle - 1, sibling->keys, 0);
+          std::copy(parent->children + middle + 1, parent->children + parent->count + 1, sibling->children);
+          sibling->count = parent->count - middle - 1;
+          parent->count  = middle;
+          right = sibling;
+        }
+
+        // Growing a new root above the split root.
+        auto root = new inner_type();
+        new (&root->keys[0]) T(std::move(*separator));
+        root->children[0] = this->root_;
+        root->children[1] = right;
+        root->count = 1;
+        this->root_ = root;
+        this->height++;
+      }
+
+      /**
+       * @brief Restores the occupancy of the `index`-th child of the given
+       * parent, borrowing an element from a sibling holding more than the
+       * minimal number of elements, or merging the child with a sibling.
+       * @param parent the parent of the child.
+       * @param index the index of the child.
+       * @param leaves whether the children of the parent are leaves.
+       */
+      void underflow(inner_type* parent, size_t index, bool leaves) {
+        auto node  = parent->children[index];
+        auto left  = index > 0 ? parent->children[index - 1] : nullptr;
+        auto right = index < parent->count ? parent->children[index + 1] : nullptr;
+
+        if (leaves) {
+          auto leaf = static_cast<leaf_type*>(node);
+
+          if (left && left->count > min_count) {
+            auto sibling = static_cast<leaf_type*>(left);
+            emplace_at(leaf->values, leaf->count++, 0, std::move(sibling->values[sibling->count - 1]));
+            erase(sibling->values, sibling->count, sibling->count - 1);
+            assign(parent->keys[index - 1], leaf->values[0].data);
+          } else if (right && right->count > min_count) {
+            auto sibling = static_cast<leaf_type*>(right);
+            relocate(sibling->values, 0, 1, leaf->values, leaf->count++);
+            relocate(sibling->values, 1, --sibling->count, sibling->values, 0);
+            assign(parent->keys[index], sibling->values[0].data);
+          } else if (left) {
+            this->merge(static_cast<leaf_type*>(left), leaf, parent, index - 1);
+          } else {
+            this->merge(leaf, static_cast<leaf_type*>(right), parent, index);
+          }
+          return;
+        }
+
+        auto inner = static_cast<inner_type*>(node);
+        if (left && left->count > min_count) {
+          // Rotating the last key of the left sibling through the parent.
+          auto sibling = static_cast<inner_type*>(left);
+          emplace_at(inner->keys, inner->count, 0, std::move(parent->keys[index - 1]));
+          std::copy_backward(inner->children, inner->children + inner->count + 1, inner->children + inner->count + 2);
+          inner->children[0] = sibling->children[sibling->count];
+          inner->count++;
+          parent->keys[index - 1].~T();
+          relocate(sibling->keys, sibling->count - 1, 1, parent->keys, index - 1);
+          sibling->count--;
+        } else if (right && right->count > min_count) {
+          // Rotating the first key of the right sibling through the parent.
+          auto sibling = static_cast<inner_type*>(right);
+          relocate(parent->keys, index, 1, inner->keys, inner->count);
+          inner->children[++inner->count] = sibling->children[0];
+          relocate(sibling->keys, 0, 1, parent->keys, index);
+          relocate(sibling->keys, 1, sibling->count - 1, sibling->keys, 0);
+          std::copy(sibling->children + 1, sibling->children + sibling->count + 1, sibling->children);
+          sibling->count--;
+        } else if (left) {
+          this->merge(static_cast<inner_type*>(left), inner, parent, index - 1);
+        } else {
+          this->merge(inner, static_cast<inner_type*>(right), parent, index);
+        }
+      }
+
+      /**
+       * @brief Appends the values of the given leaf to its left sibling,
+       * and removes it with its separator from their parent.
+       */
+      void merge(leaf_type* left, leaf_type* right, inner_type* parent, size_t separator) {
+        relocate(right->values, 0, right->count, left->values, left->count);
+        left->count += right->count;
+        left->next = right->next;
+        (right->next ? right->next->prev : this->tail) = left;
+        delete right;
+        parent->keys[separator].~T();
+        remove_child(parent, separator);
+      }
+
+      /**
+       * @brief Appends the separator and the keys and children of the given
+       * inner node to its left sibling, and removes it from their parent.
+       */
+      void merge(inner_type* left, inner_type* right, inner_type* parent, size_t separator) {
+        relocate(parent->keys, separator, 1, left->keys, left->count);
+        relocate(right->keys, 0, right->count, left->keys, left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        delete right;
+        remove_child(parent, separator);
+      }
+
+      /**
+       * @brief Removes the given separator of the given parent, which must
+       * have been destroyed or moved away, and the child following it.
+       */
+      static void remove_child(inner_type* parent, size_t separator) {
+        std::copy(parent->children + separator + 2, parent->children + parent->count + 1, parent->children + separator + 1);
+        relocate(parent->keys, separator + 1, parent->count - separator - 1, parent->keys, separator);
+        parent->count--;
+      }
+
+      /**
+       * @brief Removes the root while it is an inner node with a single
+       * child, or an empty leaf.
+       */
+      void shrink() {
+        if (this->height > 1 && this->root_->count == 0) {
+          auto root = static_cast<inner_type*>(this->root_);
+          this->root_ = root->children[0];
+          this->height--;
+          delete root;
+        } else if (this->height == 1 && this->root_->count == 0) {
+          delete static_cast<leaf_type*>(this->root_);
+          this->root_ = this->head = this->tail = nullptr;
+          this->height = 0;
+        }
+      }
+
+      /**
+       * @brief Destroys the given subtree, of the given height.
+       */
+      static void destroy(node_base_t* node, size_t height) {
+        if (!node) {
+          return;
+        }
+        if (height == 1) {
+          auto leaf = static_cast<leaf_type*>(node);
+          for (size_t i = 0; i < leaf->count; ++i) {
+            leaf->values[i].~node_type();
+          }
+          delete leaf;
+          return;
+        }
+        auto inner = static_cast<inner_type*>(node);
+        for (size_t i = 0; i <= inner->count; ++i) {
+          destroy(inner->children[i], height - 1);
+        }
+        for (size_t i = 0; i < inner->count; ++i) {
+          inner->keys[i].~T();
+        }
+        delete inner;
+      }
+
+      node_base_t* root_         = nullptr;
+      leaf_type*   head          = nullptr;
+      leaf_type*   tail          = nullptr;
+      size_t       size_of_tree  = 0;
+      size_t       height        = 0;
+      Options      options;
   };
 };
 
@@ -0,0 +1,91 @@
+#ifndef TREE_INVARIANTS
+#define TREE_INVARIANTS
+
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Verifies the red-black properties of the given subtree.
+ * @param node the root of the subtree.
+ * @return the black-height of the subtree, or -1 if one of
+ * the properties is violated.
+ */
+template <typename Node>
+static int black_height_of(const Node* node) {
+  if (!node) return (1);
+
+  // A red node cannot have a red child.
+  if (node->color == bst::RED) {
+    if ((node->left && node->left->color == bst::RED) || (node->right && node->right->color == bst::RED))
+      return (-1);
+  }
+
+  // Parent links must be consistent.
+  if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    return (-1);
+
+  int left  = black_height_of(node->left);
+  int right = black_height_of(node->right);
+
+  if (left < 0 || left != right)
+    return (-1);
+
+  // The stored black-height must be accurate, null leaves aside.
+  int height = left + (node->color == bst::BLACK ? 1 : 0);
+  if (node->black_height != height - 1)
+    return (-1);
+  return (height);
+}
+
+/**
+ * @brief Verifies the AVL properties of the given subtree.
+ * @param node the root of the subtree.
+ * @return the height of the subtree, or -1 if one of
+ * the properties is violated.
+ */
+template <typename Node>
+static int avl_height_of(const Node* node) {
+  if (!node) return (0);
+
+  int left  = avl_height_of(node->left);
+  int right = avl_height_of(node->right);
+
+  // The stored height must be accurate and the subtrees balanced.
+  if (left < 0 || right < 0 || std::abs(left - right) > 1)
+    return (-1);
+  if (node->height != 1 + std::max(left, right))
+    return (-1);
+  return (node->height);
+}
+
+/**
+ * @brief Verifies that the given tree holds the values
+ * of the given sorted container, in the same order.
+ */
+template <typename Tree, typename Container = std::vector<typename Tree::value_type>>
+static void expect_values(const Tree& tree, const Container& expected) {
+  EXPECT_EQ(tree.size(), expected.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+}
+
+/**
+ * @brief Runs the given function on `count` threads, passing
+ * each thread its index, and waits for them to return.
+ */
+template <typename Function>
+static void run_threads(int count, Function&& function) {
+  std::vector<std::thread> workers;
+
+  for (int i = 0; i < count; ++i) {
+    workers.emplace_back(function, i);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+#endif // TREE_INVARIANTS
@@ -0,0 +1,141 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+
+/**
+ * The number of live allocations made by the counting allocator.
+ */
+static int live_allocations = 0;
+
+/**
+ * @brief An allocator counting its live allocations.
+ */
+template <typename T>
+struct counting_allocator_t {
+  using value_type = T;
+
+  counting_allocator_t() = default;
+
+  template <typename U>
+  counting_allocator_t(const counting_allocator_t<U>&) {}
+
+  T* allocate(size_t n) {
+    live_allocations += n;
+    return (std::allocator<T>().allocate(n));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    live_allocations -= n;
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template <typename U>
+  bool operator==(const counting_allocator_t<U>&) const { return (true); }
+
+  template <typename U>
+  bool operator!=(const counting_allocator_t<U>&) const { return (false); }
+};
+
+TEST(ALLOCATORS, CUSTOM_ALLOCATOR) {
+  {
+    // Creating a tree using the counting allocator.
+    auto tree = bst::tree_t<int, bst::red_black_t, bst::default_options_t<int>, counting_allocator_t<int>>();
+
+    tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+    EXPECT_EQ(live_allocations, 8);
+    tree.remove(50, 10);
+    EXPECT_EQ(live_allocations, 6);
+  }
+  // Destroying the tree releases every node.
+  EXPECT_EQ(live_allocations, 0);
+}
+
+TEST(ALLOCATORS, POOL_RECYCLING) {
+  auto pool = bst::fixed_pool_t(sizeof(int), alignof(int), 4);
+
+  // Slots are carved contiguously out of a block.
+  auto a = static_cast<char*>(pool.allocate());
+  auto b = static_cast<char*>(pool.allocate());
+  EXPECT_EQ((size_t) (b - a), sizeof(void*));
+
+  // Freed slots are recycled first.
+  pool.deallocate(a);
+  EXPECT_EQ(pool.allocate(), a);
+}
+
+TEST(ALLOCATORS, POOL_ALLOCATOR_REBIND) {
+  auto allocator = bst::pool_allocator_t<int>();
+  auto rebound   = bst::pool_allocator_t<double>(allocator);
+
+  // Rebound allocators share the same resource.
+  EXPECT_TRUE(allocator == rebound);
+  EXPECT_TRUE(allocator != bst::pool_allocator_t<int>());
+}
+
+TEST(ALLOCATORS, POOL_ALLOCATOR_TREE) {
+  // Creating a tree allocating its nodes from a pool.
+  auto tree = bst::tree_t<int, bst::avl_t, bst::default_options_t<int>, bst::pool_allocator_t<int>>();
+
+  for (int i = 0; i < 10000; ++i) {
+    tree.insert(i);
+  }
+  for (int i = 0; i < 10000; i += 2) {
+    tree.remove(i);
+  }
+  for (int i = 0; i < 10000; i += 2) {
+    tree.insert(i);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) 10000);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ(*tree.begin(), 0);
+}
+
+TEST(ALLOCATORS, ARENA_RESOURCE) {
+  auto arena = bst::arena_resource_t(64);
+
+  // Allocations are aligned and carved contiguously.
+  auto a = static_cast<char*>(arena.allocate(1, 1));
+  auto b = static_cast<char*>(arena.allocate(8, 8));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, (uintptr_t) 0);
+  EXPECT_LE((size_t) (b - a), (size_t) 8);
+
+  // Allocations larger than a block get their own block.
+  EXPECT_NE(arena.allocate(1024, 16), nullptr);
+  arena.release();
+}
+
+TEST(ALLOCATORS, ARENA_TREE_CLEAR) {
+  // Creating a tree allocating its nodes from an arena.
+  auto tree = bst::arena_tree_t<int, bst::red_black_t>();
+
+  for (int i = 0; i < 10000; ++i) {
+    tree.insert(i);
+  }
+  tree.remove(0);
+  EXPECT_EQ(tree.size(), (size_t) 9999);
+
+  // Clearing the tree releases the arena at once.
+  tree.clear();
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.root(), nullptr);
+  EXPECT_EQ(tree.begin(), tree.end());
+
+  // The tree can be reused once cleared.
+  tree.insert(3, 1, 2);
+  EXPECT_EQ(tree.size(), (size_t) 3);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+}
+
+TEST(ALLOCATORS, ARENA_TREE_NON_TRIVIAL_VALUES) {
+  // Values which are not trivially destructible are destroyed one by one.
+  auto tree = bst::arena_tree_t<std::string, bst::avl_t, bst::options_t<std::string, std::less<std::string>>>();
+
+  for (int i = 0; i < 1000; ++i) {
+    tree.insert(std::string(64, 'a') + std::to_string(i));
+  }
+  tree.clear();
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.root(), nullptr);
+}
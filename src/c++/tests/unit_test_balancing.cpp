@@ -0,0 +1,364 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+/**
+ * The number of values to insert in the trees.
+ */
+static const int iterations = 10000;
+
+/**
+ * @brief Computes the height of the given subtree.
+ * @param node the root of the subtree.
+ * @return the number of nodes on the longest path from `node` to a leaf.
+ */
+template <typename Node>
+static size_t height_of(const Node* node) {
+  if (!node) return (0);
+  return (1 + std::max(height_of(node->left), height_of(node->right)));
+}
+
+TEST(BALANCING, UNBALANCED_SORTED_INSERTION) {
+  // Creating a new unbalanced binary search tree.
+  auto tree = bst::tree_t<int>();
+
+  // Inserting sorted values degrades the tree into a list.
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(i);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) 100);
+  EXPECT_EQ(height_of(tree.root()), (size_t) 100);
+}
+
+TEST(BALANCING, RED_BLACK_SORTED_INSERTION) {
+  // Creating a new red-black binary search tree.
+  auto tree = bst::red_black_tree_t<int>();
+
+  // Inserting sorted values.
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_NE(tree.insert(i), nullptr);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations);
+  EXPECT_EQ(tree.root()->color, bst::BLACK);
+  EXPECT_GT(black_height_of(tree.root()), 0);
+  EXPECT_LE(height_of(tree.root()), (size_t) (2 * std::log2(iterations + 1)));
+
+  // Every value must still be reachable.
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_TRUE(tree.find(i).has_value());
+  }
+}
+
+TEST(BALANCING, RED_BLACK_REMOVAL) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Creating a new red-black binary search tree.
+  auto tree = bst::red_black_tree_t<int>();
+  tree.insert(values.begin(), values.end());
+
+  // Removing half of the values.
+  for (int i = 0; i < iterations; i += 2) {
+    tree.remove(values[i]);
+    ASSERT_GT(black_height_of(tree.root()), 0);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations / 2);
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_EQ(tree.find(values[i]).has_value(), i % 2 == 1);
+  }
+
+  // The remaining values must be iterated in order.
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ((size_t) std::distance(tree.begin(), tree.end()), tree.size());
+
+  // Removing the remaining values.
+  tree.remove(tree.begin(), tree.end());
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.root(), nullptr);
+}
+
+TEST(BALANCING, AVL_SORTED_INSERTION) {
+  // Creating a new AVL binary search tree.
+  auto tree = bst::avl_tree_t<int>();
+
+  // Inserting sorted values.
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_NE(tree.insert(i), nullptr);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations);
+  EXPECT_GT(avl_height_of(tree.root()), 0);
+  EXPECT_LE(height_of(tree.root()), (size_t) (1.44 * std::log2(iterations + 2)));
+}
+
+TEST(BALANCING, AVL_REMOVAL) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Creating a new AVL binary search tree.
+  auto tree = bst::avl_tree_t<int>();
+  tree.insert(values.begin(), values.end());
+  EXPECT_GT(avl_height_of(tree.root()), 0);
+
+  // Removing half of the values.
+  for (int i = 0; i < iterations; i += 2) {
+    tree.remove(values[i]);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations / 2);
+  EXPECT_GT(avl_height_of(tree.root()), 0);
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_EQ(tree.find(values[i]).has_value(), i % 2 == 1);
+  }
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+}
+
+TEST(BALANCING, BUILD_FROM_SORTED) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+
+  // Building trees of every policy from the same sorted values.
+  auto unbalanced = bst::tree_t<int>();
+  auto red_black  = bst::red_black_tree_t<int>();
+  auto avl        = bst::avl_tree_t<int>();
+  unbalanced.build_from_sorted(values.begin(), values.end());
+  red_black.build_from_sorted(values.begin(), values.end());
+  avl.build_from_sorted(values.begin(), values.end());
+
+  // The trees have a minimal height.
+  auto minimal_height = (size_t) std::ceil(std::log2(iterations + 1));
+  EXPECT_EQ(height_of(unbalanced.root()), minimal_height);
+  EXPECT_EQ(height_of(red_black.root()), minimal_height);
+  EXPECT_EQ(height_of(avl.root()), minimal_height);
+
+  // The balancing metadata is consistent.
+  EXPECT_EQ(red_black.root()->color, bst::BLACK);
+  EXPECT_GT(black_height_of(red_black.root()), 0);
+  EXPECT_GT(avl_height_of(avl.root()), 0);
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), red_black.begin()));
+
+  // The trees keep being balanced once modified.
+  for (int i = 0; i < iterations; i += 3) {
+    red_black.remove(i);
+    avl.remove(i);
+    red_black.insert(iterations + i);
+    avl.insert(iterations + i);
+  }
+  EXPECT_GT(black_height_of(red_black.root()), 0);
+  EXPECT_GT(avl_height_of(avl.root()), 0);
+}
+
+TEST(BALANCING, BUILD_FROM_SORTED_SMALL_TREES) {
+  // Every size yields valid red-black and order-statistic trees.
+  for (int size = 0; size < 64; ++size) {
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto tree = bst::order_statistic_tree_t<int>();
+    tree.insert(-1, -2);
+    tree.build_from_sorted(values.begin(), values.end());
+    EXPECT_EQ(tree.size(), (size_t) size);
+    EXPECT_GT(black_height_of(tree.root()), 0);
+    for (int i = 0; i < size; ++i) {
+      EXPECT_EQ(tree.select(i)->value(), i);
+    }
+  }
+}
+
+TEST(BALANCING, BUILD_FROM_SORTED_INVALID_INPUT) {
+  auto tree = bst::red_black_tree_t<int>();
+
+  // Equal values are only inserted once.
+  std::vector<int> duplicates = { 1, 1, 2, 3, 3, 3 };
+  tree.build_from_sorted(duplicates.begin(), duplicates.end());
+  EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>({ 1, 2, 3 }));
+
+  // Unsorted values are rejected, leaving the tree untouched.
+  std::vector<int> unsorted = { 1, 3, 2 };
+  EXPECT_THROW(tree.build_from_sorted(unsorted.begin(), unsorted.end()), std::invalid_argument);
+  EXPECT_EQ(tree.size(), (size_t) 3);
+  EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>({ 1, 2, 3 }));
+  EXPECT_GT(black_height_of(tree.root()), 0);
+}
+
+TEST(BALANCING, BUILD_FROM_SORTED_ARENA) {
+  auto tree = bst::arena_tree_t<int, bst::red_black_t>();
+  tree.insert(1, 2, 3);
+
+  // Unsorted values leave the nodes of the arena untouched.
+  std::vector<int> unsorted = { 4, 6, 5 };
+  EXPECT_THROW(tree.build_from_sorted(unsorted.begin(), unsorted.end()), std::invalid_argument);
+  EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>({ 1, 2, 3 }));
+
+  // Sorted values replace them, being allocated from a new arena.
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  tree.build_from_sorted(values.begin(), values.end());
+  EXPECT_EQ(tree.size(), (size_t) iterations);
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), values.begin(), values.end()));
+  EXPECT_GT(black_height_of(tree.root()), 0);
+}
+
+TEST(BALANCING, REBALANCE_DEGENERATE_TREE) {
+  // Creating a new unbalanced binary search tree.
+  auto tree = bst::tree_t<int>();
+
+  // Inserting sorted values degrades the tree into a list.
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert(i);
+  }
+  EXPECT_EQ(tree.stats().height, (size_t) iterations);
+
+  // Rebalancing the tree restores a minimal height.
+  tree.rebalance();
+  EXPECT_EQ(tree.stats().size, (size_t) iterations);
+  EXPECT_EQ(tree.stats().height, (size_t) std::ceil(std::log2(iterations + 1)));
+  EXPECT_EQ(tree.root()->parent, nullptr);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ((size_t) std::distance(tree.begin(), tree.end()), tree.size());
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_TRUE(tree.find(i).has_value());
+  }
+}
+
+TEST(BALANCING, REBALANCE_POLICIES) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Rebalancing resets the metadata of the balancing policies.
+  for (int size : { 0, 1, 2, 3, 7, 100, iterations }) {
+    auto red_black = bst::order_statistic_tree_t<int, bst::red_black_t>();
+    auto avl = bst::avl_tree_t<int>();
+    red_black.insert(values.begin(), values.begin() + size);
+    avl.insert(values.begin(), values.begin() + size);
+
+    red_black.rebalance();
+    avl.rebalance();
+    EXPECT_EQ(red_black.stats().height, (size_t) std::ceil(std::log2(size + 1)));
+    EXPECT_EQ(avl.stats().height, (size_t) std::ceil(std::log2(size + 1)));
+    EXPECT_GT(black_height_of(red_black.root()), 0);
+    EXPECT_EQ(avl_height_of(avl.root()), (int) avl.stats().height);
+    std::vector<int> sorted(values.begin(), values.begin() + size);
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < size; ++i) {
+      EXPECT_EQ(red_black.select(i)->value(), sorted[i]);
+    }
+
+    // The trees keep being balanced once modified.
+    red_black.remove(values.begin(), values.begin() + size / 2);
+    avl.remove(values.begin(), values.begin() + size / 2);
+    EXPECT_GT(black_height_of(red_black.root()), 0);
+    EXPECT_GE(avl_height_of(avl.root()), 0);
+  }
+}
+
+TEST(BALANCING, SCAPEGOAT_SORTED_INSERTION) {
+  // Scapegoat nodes are as small as unbalanced nodes.
+  static_assert(sizeof(bst::scapegoat_tree_t<int>::node_type) == sizeof(bst::tree_t<int>::node_type));
+
+  // Creating a new scapegoat binary search tree.
+  auto tree = bst::scapegoat_tree_t<int>();
+
+  // Inserting sorted values.
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_NE(tree.insert(i), nullptr);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations);
+  EXPECT_LE(tree.stats().height, (size_t) (std::log(iterations) / std::log(1.5)) + 1);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_TRUE(tree.find(i).has_value());
+  }
+}
+
+TEST(BALANCING, SCAPEGOAT_REMOVAL) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Creating a new scapegoat binary search tree.
+  auto tree = bst::order_statistic_tree_t<int, bst::scapegoat_t>();
+  tree.insert(values.begin(), values.end());
+
+  // Removing most of the values rebuilds the tree.
+  for (int i = 0; i < iterations * 9 / 10; ++i) {
+    tree.remove(values[i]);
+  }
+
+  auto size = (size_t) (iterations - iterations * 9 / 10);
+  EXPECT_EQ(tree.size(), size);
+  EXPECT_LE(tree.stats().height, (size_t) (std::log(size) / std::log(1.5)) + 1);
+  std::vector<int> sorted(values.begin() + iterations * 9 / 10, values.end());
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), tree.begin()));
+  for (size_t i = 0; i < size; ++i) {
+    EXPECT_EQ(tree.select(i)->value(), sorted[i]);
+  }
+
+  // The tree can be reused once cleared.
+  tree.clear();
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(i);
+  }
+  EXPECT_LE(tree.stats().height, (size_t) (std::log(100) / std::log(1.5)) + 1);
+}
+
+TEST(BALANCING, SPLAY_ACCESS) {
+  // Creating a new splay binary search tree.
+  auto tree = bst::splay_tree_t<int>();
+
+  // Inserted values are moved to the root.
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(i);
+    EXPECT_EQ(tree.root()->value(), i);
+  }
+
+  // Looked up values are moved to the root.
+  EXPECT_EQ(tree.find(0).value()->value(), 0);
+  EXPECT_EQ(tree.root()->value(), 0);
+  EXPECT_LT(tree.stats().height, (size_t) 100);
+
+  // Missing values move the last visited node to the root.
+  EXPECT_FALSE(tree.find(1000).has_value());
+  EXPECT_EQ(tree.root()->value(), 99);
+
+  // Lookups on a const tree do not restructure it.
+  const auto& view = tree;
+  EXPECT_EQ(view.find(50).value()->value(), 50);
+  EXPECT_EQ(tree.root()->value(), 99);
+}
+
+TEST(BALANCING, SPLAY_REMOVAL) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Creating a new splay binary search tree.
+  auto tree = bst::order_statistic_tree_t<int, bst::splay_t>();
+  tree.insert(values.begin(), values.end());
+
+  // Removing half of the values.
+  for (int i = 0; i < iterations; i += 2) {
+    tree.remove(values[i]);
+  }
+
+  EXPECT_EQ(tree.size(), (size_t) iterations / 2);
+  for (int i = 0; i < iterations; ++i) {
+    EXPECT_EQ(tree.find(values[i]).has_value(), i % 2 == 1);
+  }
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ((size_t) std::distance(tree.begin(), tree.end()), tree.size());
+  EXPECT_EQ(tree.rank(tree.root()->value()), (size_t) std::distance(tree.begin(), std::find(tree.begin(), tree.end(), tree.root()->value())));
+}
@@ -0,0 +1,144 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Verifies that the given B+tree holds the values of the
+ * given set, and that its bounds are the ones of the set.
+ */
+template <typename Tree, typename Set>
+static void expect_btree(const Tree& tree, const Set& expected) {
+  expect_values(tree, expected);
+  ASSERT_EQ(tree.empty(), expected.empty());
+  if (expected.empty()) {
+    EXPECT_EQ(tree.min(), nullptr);
+    EXPECT_EQ(tree.max(), nullptr);
+    EXPECT_EQ(tree.stats().height, (size_t) 0);
+  } else {
+    EXPECT_EQ(tree.min()->value(), *expected.begin());
+    EXPECT_EQ(tree.max()->value(), *expected.rbegin());
+  }
+}
+
+/**
+ * @brief Inserts and removes random values in a B+tree, against a `std::set`,
+ * the values being made from integers by the given function.
+ */
+template <typename Tree, typename Make>
+static void check_btree(Make&& make) {
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(0, 3000);
+  auto tree = Tree();
+  std::set<typename Tree::value_type> expected;
+
+  // Growing the tree, then shrinking it back to an empty tree.
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 4000; ++i) {
+      auto value = make(distribution(engine));
+      auto node = tree.insert(value);
+
+      EXPECT_EQ(node != nullptr, expected.insert(value).second);
+      if (node) {
+        EXPECT_EQ(node->value(), value);
+      }
+    }
+    expect_btree(tree, expected);
+
+    for (int i = 0; i < 3000; ++i) {
+      auto value = make(distribution(engine));
+      tree.remove(value);
+      expected.erase(value);
+    }
+    expect_btree(tree, expected);
+
+    for (int key = 0; key <= 3000; key += 7) {
+      auto value = make(key);
+      auto node = tree.find(value);
+
+      ASSERT_EQ(node.has_value(), expected.count(value) == 1);
+      if (node) {
+        EXPECT_EQ((*node)->value(), value);
+      }
+    }
+  }
+
+  std::vector<typename Tree::value_type> values(expected.begin(), expected.end());
+  std::shuffle(values.begin(), values.end(), engine);
+  tree.remove(values.begin(), values.end());
+  expected.clear();
+  expect_btree(tree, expected);
+}
+
+TEST(BTREE, SMALL_NODES) {
+  check_btree<bst::btree_t<int, bst::default_options_t<int>, 4>>([] (int i) { return (i); });
+  check_btree<bst::btree_t<int, bst::default_options_t<int>, 5>>([] (int i) { return (i); });
+}
+
+TEST(BTREE, DEFAULT_NODES) {
+  check_btree<bst::btree_t<int>>([] (int i) { return (i); });
+  check_btree<bst::btree_t<int64_t>>([] (int i) { return ((int64_t) i << 32); });
+}
+
+TEST(BTREE, STRINGS) {
+  // Values owning memory are moved between nodes without leaking.
+  auto make = [] (int i) { return (std::string(32, 'a') + std::to_string(i)); };
+  check_btree<bst::btree_t<std::string, bst::default_options_t<std::string>, 4>>(make);
+  check_btree<bst::btree_t<std::string>>(make);
+}
+
+TEST(BTREE, HEIGHT) {
+  auto tree = bst::btree_t<int, bst::default_options_t<int>, 16>();
+  for (int i = 0; i < 100000; ++i) {
+    tree.insert(i);
+  }
+
+  // Nodes are at least half full.
+  EXPECT_EQ(tree.size(), (size_t) 100000);
+  EXPECT_LE(tree.stats().height, (size_t) std::ceil(std::log(100000) / std::log(8)) + 1);
+  EXPECT_GE(tree.stats().height, (size_t) 4);
+}
+
+TEST(BTREE, CUSTOM_COMPARATOR) {
+  // Values are stored in descending order.
+  auto options = bst::options_t<int>([] (const int& lhs, const int& rhs) { return (rhs - lhs); });
+  auto tree = bst::btree_t<int, bst::options_t<int>, 4>(options);
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(i);
+  }
+  EXPECT_EQ(*tree.begin(), 99);
+  EXPECT_EQ(tree.min()->value(), 99);
+  EXPECT_EQ(tree.max()->value(), 0);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end(), std::greater<int>()));
+}
+
+TEST(BTREE, MOVE) {
+  // Moving does not throw, unless copying the options does, so that
+  // containers of trees move them when growing.
+  using type_erased_t = bst::btree_t<int, bst::options_t<int>>;
+  static_assert(std::is_nothrow_move_constructible_v<bst::btree_t<int>>);
+  static_assert(std::is_nothrow_move_assignable_v<bst::btree_t<int>>);
+  static_assert(!std::is_nothrow_move_constructible_v<type_erased_t>);
+  static_assert(!std::is_nothrow_move_assignable_v<type_erased_t>);
+
+  auto tree = bst::btree_t<int>();
+  tree.insert(1);
+  tree.insert(2);
+
+  auto other = std::move(tree);
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.begin(), tree.end());
+  EXPECT_EQ(other.size(), (size_t) 2);
+
+  tree = std::move(other);
+  EXPECT_EQ(tree.size(), (size_t) 2);
+  EXPECT_EQ(other.size(), (size_t) 0);
+  EXPECT_TRUE(tree.find(2).has_value());
+}
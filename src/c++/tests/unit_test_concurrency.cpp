@@ -0,0 +1,229 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * The number of threads accessing the trees.
+ */
+static const int threads = 4;
+
+/**
+ * The number of values handled by each thread.
+ */
+static const int iterations = 20000;
+
+/**
+ * @return the values of the given tree, in the order they are visited.
+ */
+template <typename Tree>
+static std::vector<typename Tree::value_type> values_of(const Tree& tree) {
+  std::vector<typename Tree::value_type> values;
+  tree.for_each([&] (const auto& value) { values.push_back(value); });
+  return (values);
+}
+
+/**
+ * @brief Mirrors random insertions and removals of a single thread in a set.
+ */
+template <typename Tree>
+static void check_sequential() {
+  auto tree = Tree();
+  auto expected = std::set<int>();
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(0, 999);
+
+  EXPECT_TRUE(tree.empty());
+  EXPECT_FALSE(tree.remove(1));
+  EXPECT_FALSE(tree.find(1).has_value());
+
+  // Mirroring random insertions and removals in a set.
+  for (int i = 0; i < iterations; ++i) {
+    int value = distribution(engine);
+    if (i % 3) {
+      EXPECT_EQ(tree.insert(value), expected.insert(value).second);
+    } else {
+      EXPECT_EQ(tree.remove(value), expected.erase(value) == 1);
+    }
+    EXPECT_EQ(tree.contains(value), expected.count(value) == 1);
+  }
+  EXPECT_EQ(tree.size(), expected.size());
+  EXPECT_EQ(values_of(tree), std::vector<int>(expected.begin(), expected.end()));
+}
+
+/**
+ * @brief Stores values that are not trivially copyable,
+ * in a tree of strings.
+ */
+template <typename Tree>
+static void check_find_copies_values() {
+  auto tree = Tree();
+
+  EXPECT_TRUE(tree.insert(std::string("b")));
+  EXPECT_TRUE(tree.insert(std::string("a")));
+  EXPECT_FALSE(tree.insert(std::string("b")));
+  EXPECT_EQ(tree.find(std::string("a")).value(), "a");
+  EXPECT_TRUE(tree.remove(std::string("a")));
+  EXPECT_TRUE(tree.remove(std::string("b")));
+  EXPECT_TRUE(tree.empty());
+}
+
+/**
+ * @brief Inserts values from several threads, every value being
+ * inserted by two threads, only one of which must succeed.
+ */
+template <typename Tree>
+static void check_concurrent_insertions() {
+  auto tree = Tree();
+  std::vector<int> values(threads * iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Every thread inserts its share of the values, along with values
+  // inserted by the other threads, which must be rejected.
+  std::atomic<int> inserted{0};
+  run_threads(threads, [&] (int thread) {
+    for (int i = 0; i < iterations; ++i) {
+      inserted += tree.insert(values[thread * iterations + i]);
+      tree.insert(values[((thread + 1) % threads) * iterations + i]);
+    }
+  });
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(tree.size(), values.size());
+  EXPECT_EQ(values_of(tree), values);
+  EXPECT_LE(inserted.load(), threads * iterations);
+}
+
+/**
+ * @brief Removes the values of a tree from several threads,
+ * every value being removed by exactly one thread.
+ */
+template <typename Tree>
+static void check_concurrent_removals() {
+  auto tree = Tree();
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+  for (auto value : values) {
+    tree.insert(value);
+  }
+
+  // Every value is removed by exactly one of the threads.
+  std::atomic<int> removed{0};
+  run_threads(threads, [&] (int thread) {
+    for (int i = 0; i < iterations; ++i) {
+      removed += tree.remove(values[(thread * iterations / threads + i) % iterations]);
+    }
+  });
+  EXPECT_EQ(removed.load(), iterations);
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(values_of(tree).empty());
+}
+
+/**
+ * @brief Looks up values that are never removed while
+ * writers insert and remove the other values.
+ */
+template <typename Tree>
+static void check_readers_and_writers() {
+  auto tree = Tree();
+
+  // Even values are never removed, odd values come and go.
+  std::vector<int> values(iterations / 2);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+  for (auto value : values) {
+    tree.insert(2 * value);
+  }
+
+  std::atomic<int> missing{0};
+  run_threads(threads, [&] (int thread) {
+    auto engine = std::mt19937(thread);
+    auto distribution = std::uniform_int_distribution<int>(0, iterations / 2 - 1);
+
+    for (int i = 0; i < iterations; ++i) {
+      int value = distribution(engine);
+      if (thread % 2) {
+        missing += !tree.contains(2 * value);
+        missing += tree.find(2 * value).value_or(-1) != 2 * value;
+      } else if (i % 2) {
+        tree.insert(2 * value + 1);
+      } else {
+        tree.remove(2 * value + 1);
+      }
+    }
+  });
+  EXPECT_EQ(missing.load(), 0);
+
+  values = values_of(tree);
+  EXPECT_EQ(values.size(), tree.size());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_EQ(std::count_if(values.begin(), values.end(), [] (int value) { return (value % 2 == 0); }), iterations / 2);
+}
+
+/**
+ * @brief Inserts and removes a handful of values from every thread,
+ * so that writers keep running into each other.
+ */
+template <typename Tree>
+static void check_contended_writers() {
+  auto tree = Tree();
+
+  run_threads(threads, [&] (int thread) {
+    auto engine = std::mt19937(thread);
+    auto distribution = std::uniform_int_distribution<int>(0, 15);
+
+    for (int i = 0; i < iterations; ++i) {
+      if (i % 2) {
+        tree.insert(distribution(engine));
+      } else {
+        tree.remove(distribution(engine));
+      }
+    }
+  });
+
+  auto values = values_of(tree);
+  EXPECT_EQ(values.size(), tree.size());
+  EXPECT_TRUE(std::adjacent_find(values.begin(), values.end(), std::greater_equal<int>()) == values.end());
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(tree.contains(i), std::binary_search(values.begin(), values.end(), i));
+  }
+}
+
+TEST(CONCURRENCY, SEQUENTIAL) {
+  check_sequential<bst::concurrent_tree_t<int>>();
+  check_sequential<bst::lock_free_tree_t<int>>();
+}
+
+TEST(CONCURRENCY, FIND_COPIES_VALUES) {
+  check_find_copies_values<bst::concurrent_tree_t<std::string>>();
+  check_find_copies_values<bst::lock_free_tree_t<std::string>>();
+}
+
+TEST(CONCURRENCY, CONCURRENT_INSERTIONS) {
+  check_concurrent_insertions<bst::concurrent_tree_t<int>>();
+  check_concurrent_insertions<bst::lock_free_tree_t<int>>();
+}
+
+TEST(CONCURRENCY, CONCURRENT_REMOVALS) {
+  check_concurrent_removals<bst::concurrent_tree_t<int>>();
+  check_concurrent_removals<bst::lock_free_tree_t<int>>();
+}
+
+TEST(CONCURRENCY, READERS_AND_WRITERS) {
+  check_readers_and_writers<bst::concurrent_tree_t<int>>();
+  check_readers_and_writers<bst::lock_free_tree_t<int>>();
+}
+
+TEST(CONCURRENCY, CONTENDED_WRITERS) {
+  check_contended_writers<bst::concurrent_tree_t<int>>();
+  check_contended_writers<bst::lock_free_tree_t<int>>();
+}
@@ -0,0 +1,113 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Verifies the look-ups of frozen copies of trees of various
+ * sizes, including the sizes of complete and almost complete trees.
+ */
+template <typename Tree>
+static void check_frozen() {
+  for (int size : {0, 1, 2, 3, 6, 7, 8, 15, 16, 100, 1023, 1024, 5000}) {
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+    // Storing even values, so that odd keys are missing.
+    auto tree = Tree();
+    for (auto value : values) {
+      tree.insert(2 * value);
+    }
+    auto frozen = tree.freeze();
+
+    EXPECT_EQ(frozen.size(), (size_t) size);
+    EXPECT_EQ(frozen.empty(), size == 0);
+    EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), tree.begin(), tree.end()));
+
+    for (int key = -1; key <= 2 * size; ++key) {
+      auto value = frozen.find(key);
+      auto bound = frozen.lower_bound(key);
+
+      if (key >= 0 && key % 2 == 0 && key < 2 * size) {
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, key);
+        EXPECT_TRUE(frozen.contains(key));
+      } else {
+        EXPECT_EQ(value, nullptr);
+        EXPECT_FALSE(frozen.contains(key));
+      }
+      if (key < 2 * size - 1) {
+        ASSERT_NE(bound, frozen.end());
+        EXPECT_EQ(*bound, std::max(key + (key & 1), 0));
+      } else {
+        EXPECT_EQ(bound, frozen.end());
+      }
+    }
+  }
+}
+
+TEST(FROZEN, LOOKUPS) {
+  check_frozen<bst::tree_t<int>>();
+  check_frozen<bst::red_black_tree_t<int>>();
+  check_frozen<bst::avl_tree_t<int>>();
+}
+
+TEST(FROZEN, UNTOUCHED_BY_MUTATIONS) {
+  auto tree = bst::red_black_tree_t<int>();
+  tree.insert(1, 2, 3);
+
+  auto frozen = tree.freeze();
+  tree.remove(2);
+  tree.insert(4);
+
+  EXPECT_TRUE(frozen.contains(2));
+  EXPECT_FALSE(frozen.contains(4));
+  EXPECT_EQ(std::distance(frozen.begin(), frozen.end()), 3);
+}
+
+TEST(FROZEN, CUSTOM_COMPARATOR) {
+  // Values are ordered by length, the comparator of the tree being reused.
+  auto options = bst::options_t<std::string>([] (const std::string& lhs, const std::string& rhs) {
+    return ((int) lhs.size() - (int) rhs.size());
+  });
+  auto tree = bst::tree_t<std::string, bst::avl_t, bst::options_t<std::string>>(options);
+  tree.insert(std::string("ccc"), std::string("a"), std::string("eeeee"), std::string("dddd"));
+
+  auto frozen = tree.freeze();
+  auto expected = std::vector<std::string>{"a", "ccc", "dddd", "eeeee"};
+
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(*frozen.find(std::string("xyz")), "ccc");
+  EXPECT_EQ(*frozen.lower_bound(std::string("xy")), "ccc");
+  EXPECT_EQ(frozen.find(std::string("xy")), nullptr);
+  EXPECT_EQ(frozen.lower_bound(std::string("xxxxxx")), frozen.end());
+}
+
+TEST(FROZEN, CACHE_LINE_ALIGNMENT) {
+  std::vector<int> values(20);
+  std::iota(values.begin(), values.end(), 0);
+
+  // The smallest of 20 values has the Eytzinger index 16, and starts the
+  // cache line holding the descendants of the root 4 levels below.
+  auto frozen = bst::frozen_tree_t<int>(values.begin(), values.end());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&*frozen.begin()) % 64, (uintptr_t) 0);
+  EXPECT_EQ(*frozen.begin(), 0);
+}
+
+TEST(FROZEN, WITHOUT_PREFETCHING) {
+  std::vector<int> values(5000);
+  std::iota(values.begin(), values.end(), 0);
+
+  auto frozen = bst::frozen_tree_t<int, bst::default_options_t<int>, false>(values.begin(), values.end());
+  EXPECT_EQ(frozen.size(), values.size());
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), values.begin(), values.end()));
+  for (int key = -1; key <= 5000; ++key) {
+    EXPECT_EQ(frozen.contains(key), key >= 0 && key < 5000);
+  }
+}
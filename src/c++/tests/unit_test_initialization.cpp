@@ -1,6 +1,7 @@
 #include <binary_search_tree.hpp>
 #include <gtest/gtest.h>
 #include <stdint.h>
+#include <type_traits>
 
 TEST(INITIALIZATION, OF_TREE) {
   // Creating a new binary search tree.
@@ -10,6 +11,24 @@ TEST(INITIALIZATION, OF_TREE) {
   EXPECT_EQ(tree.root(), nullptr);
 }
 
+TEST(INITIALIZATION, MOVE) {
+  // Moving does not throw, unless copying the options does.
+  using type_erased_t = bst::tree_t<int, bst::unbalanced_t, bst::options_t<int>>;
+  static_assert(std::is_nothrow_move_constructible_v<bst::tree_t<int>>);
+  static_assert(std::is_nothrow_move_assignable_v<bst::tree_t<int>>);
+  static_assert(!std::is_nothrow_move_constructible_v<type_erased_t>);
+  static_assert(!std::is_nothrow_move_assignable_v<type_erased_t>);
+
+  auto tree = bst::tree_t<int>();
+  tree.insert(1);
+  tree.insert(2);
+
+  auto moved = std::move(tree);
+  EXPECT_EQ(moved.size(), (size_t) 2);
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.root(), nullptr);
+}
+
 TEST(INITIALIZATION, OF_NODE) {
   // Creating a new node.
   auto node = bst::node_t<int>(50);
@@ -17,6 +36,5 @@ TEST(INITIALIZATION, OF_NODE) {
   EXPECT_EQ(node.left, nullptr);
   EXPECT_EQ(node.right, nullptr);
   EXPECT_EQ(node.parent, nullptr);
-  EXPECT_EQ(node.tree, nullptr);
   EXPECT_EQ(node.value(), 50);
 }
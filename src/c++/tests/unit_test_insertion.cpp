@@ -0,0 +1,166 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <string>
+
+/**
+ * @brief A record counting the number of times it is
+ * constructed and copied.
+ */
+struct record_t {
+  int id;
+  std::string payload;
+
+  static inline int constructions = 0;
+  static inline int copies = 0;
+
+  record_t(int id, std::string payload) : id{id}, payload{std::move(payload)} {
+    constructions++;
+  }
+
+  record_t(const record_t& other) : id{other.id}, payload{other.payload} {
+    copies++;
+  }
+
+  record_t(record_t&& other) = default;
+};
+
+/**
+ * @brief A comparator ordering records by identifier, which
+ * also compares identifiers with records.
+ */
+struct record_comparator_t {
+  int operator()(const record_t& a, const record_t& b) const {
+    return ((a.id > b.id) - (a.id < b.id));
+  }
+
+  int operator()(int id, const record_t& b) const {
+    return ((id > b.id) - (id < b.id));
+  }
+};
+
+/**
+ * @brief A tree of records.
+ */
+using record_tree_t = bst::tree_t<
+  record_t,
+  bst::red_black_t,
+  bst::options_t<record_t, record_comparator_t, std::function<std::string(const record_t&)>>
+>;
+
+TEST(INSERTION, OF_RVALUE) {
+  auto tree = record_tree_t();
+  auto record = record_t(1, std::string(1024, 'a'));
+
+  record_t::copies = 0;
+  auto node = tree.insert(std::move(record));
+
+  // The record is moved into the node.
+  EXPECT_NE(node, nullptr);
+  EXPECT_EQ(record_t::copies, 0);
+  EXPECT_EQ(node->value().payload.size(), (size_t) 1024);
+
+  // Duplicates are not moved.
+  auto duplicate = record_t(1, "b");
+  EXPECT_EQ(tree.insert(std::move(duplicate)), nullptr);
+  EXPECT_EQ(duplicate.payload, "b");
+}
+
+TEST(INSERTION, OF_LVALUE) {
+  auto tree = record_tree_t();
+  auto record = record_t(1, "a");
+
+  record_t::copies = 0;
+  EXPECT_NE(tree.insert(record), nullptr);
+  EXPECT_EQ(record_t::copies, 1);
+
+  // Duplicates are not copied.
+  EXPECT_EQ(tree.insert(record), nullptr);
+  EXPECT_EQ(record_t::copies, 1);
+}
+
+TEST(INSERTION, EMPLACE) {
+  auto tree = record_tree_t();
+
+  record_t::copies = 0;
+  record_t::constructions = 0;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_NE(tree.emplace(i, "value"), nullptr);
+  }
+
+  // Values are constructed in place.
+  EXPECT_EQ(record_t::constructions, 100);
+  EXPECT_EQ(record_t::copies, 0);
+  EXPECT_EQ(tree.size(), (size_t) 100);
+
+  // Duplicates are constructed then discarded.
+  EXPECT_EQ(tree.emplace(50, "value"), nullptr);
+  EXPECT_EQ(tree.size(), (size_t) 100);
+}
+
+TEST(INSERTION, TRY_EMPLACE) {
+  auto tree = record_tree_t();
+
+  record_t::constructions = 0;
+  EXPECT_NE(tree.try_emplace(1, 1, "a"), nullptr);
+  EXPECT_NE(tree.try_emplace(2, 2, "b"), nullptr);
+  EXPECT_EQ(record_t::constructions, 2);
+
+  // Values are not constructed when the key exists.
+  EXPECT_EQ(tree.try_emplace(1, 1, "c"), nullptr);
+  EXPECT_EQ(record_t::constructions, 2);
+  EXPECT_EQ(tree.min()->value().payload, "a");
+}
+
+TEST(INSERTION, BULK_INSERT) {
+  std::vector<int> values(100000);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Duplicating some of the values.
+  values.insert(values.end(), values.begin(), values.begin() + 1000);
+
+  auto pool = bst::thread_pool_t(3);
+  auto tree = bst::red_black_tree_t<int>();
+  tree.bulk_insert(values.begin(), values.end(), pool);
+
+  EXPECT_EQ(tree.size(), (size_t) 100000);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ((size_t) std::distance(tree.begin(), tree.end()), tree.size());
+  EXPECT_LE(tree.stats().height, (size_t) std::ceil(std::log2(100001)));
+}
+
+TEST(INSERTION, BULK_INSERT_INTO_TREE) {
+  auto tree = record_tree_t();
+  tree.try_emplace(1, 1, "existing");
+
+  // Values of the tree are kept over inserted values.
+  std::vector<record_t> records;
+  for (int i = 0; i < 10000; ++i) {
+    records.emplace_back(10000 - i, "inserted");
+  }
+  tree.bulk_insert(records.begin(), records.end());
+
+  EXPECT_EQ(tree.size(), (size_t) 10000);
+  EXPECT_EQ(tree.min()->value().payload, "existing");
+  EXPECT_EQ(tree.max()->value().id, 10000);
+  EXPECT_EQ(tree.root()->color, bst::BLACK);
+}
+
+TEST(INSERTION, BULK_INSERT_POOLED) {
+  auto tree = bst::tree_t<int, bst::scapegoat_t, bst::default_options_t<int>, bst::pool_allocator_t<int>>();
+  std::vector<int> values(10000);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  // Nodes are allocated sequentially from the pool.
+  tree.bulk_insert(values.begin(), values.begin() + 5000);
+  tree.bulk_insert(values.begin() + 2500, values.end());
+  EXPECT_EQ(tree.size(), (size_t) 10000);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  EXPECT_EQ((size_t) std::distance(tree.begin(), tree.end()), tree.size());
+}
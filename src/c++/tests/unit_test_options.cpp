@@ -0,0 +1,89 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A comparator ordering integers in descending order.
+ */
+struct descending_comparator_t {
+  int operator()(int a, int b) const {
+    return ((a < b) - (b < a));
+  }
+};
+
+TEST(OPTIONS, DEFAULT_COMPARATOR) {
+  auto compare = bst::default_comparator_t<double>();
+
+  // Differences smaller than one must not be truncated.
+  EXPECT_LT(compare(2.0, 2.5), 0);
+  EXPECT_GT(compare(2.5, 2.0), 0);
+  EXPECT_EQ(compare(2.5, 2.5), 0);
+}
+
+TEST(OPTIONS, COMPILE_TIME_COMPARATOR) {
+  // Creating a tree ordered in descending order.
+  auto tree = bst::tree_t<
+    int,
+    bst::unbalanced_t,
+    bst::options_t<int, descending_comparator_t, bst::default_stringifier_t<int>>
+  >();
+
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+  EXPECT_EQ(tree.min()->value(), 100);
+  EXPECT_EQ(tree.max()->value(), 10);
+  EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end(), std::greater<int>()));
+}
+
+TEST(OPTIONS, LESS_COMPARATOR) {
+  // Creating a tree using a boolean comparator.
+  auto tree = bst::red_black_tree_t<
+    std::string,
+    bst::options_t<std::string, std::less<std::string>, std::function<std::string(const std::string&)>>
+  >();
+
+  tree.insert("abc", "aaa", "bbb", "ab");
+  EXPECT_EQ(tree.size(), (size_t) 4);
+  EXPECT_EQ(tree.insert(std::string("aaa")), nullptr);
+  EXPECT_EQ(tree.min()->value(), "aaa");
+  EXPECT_EQ(tree.max()->value(), "bbb");
+  EXPECT_TRUE(tree.find("ab").has_value());
+}
+
+TEST(OPTIONS, RUNTIME_COMPARATOR) {
+  // Creating a tree using type-erased options.
+  auto tree = bst::tree_t(bst::options_t<int>(
+    [] (const int& a, const int& b) -> int {
+      return ((a < b) - (b < a));
+    },
+    [] (const int& value) -> std::string {
+      return (std::to_string(value));
+    }
+  ));
+
+  // The type of the options is deduced from the constructor argument.
+  static_assert(std::is_same_v<decltype(tree), bst::tree_t<int, bst::unbalanced_t, bst::options_t<int>>>);
+  tree.insert(50, 70, 60, 20);
+  EXPECT_EQ(tree.min()->value(), 70);
+  EXPECT_EQ(tree.max()->value(), 20);
+}
+
+TEST(OPTIONS, EXPLICIT_RUNTIME_COMPARATOR) {
+  // Naming the type of the options, as trees of another balancing policy require.
+  auto options = bst::options_t<int>(
+    [] (const int& a, const int& b) -> int {
+      return ((a < b) - (b < a));
+    },
+    [] (const int& value) -> std::string {
+      return (std::to_string(value));
+    }
+  );
+  auto tree = bst::tree_t<int, bst::red_black_t, bst::options_t<int>>(options);
+
+  tree.insert(50, 70, 60, 20);
+  EXPECT_EQ(tree.min()->value(), 70);
+  EXPECT_EQ(tree.max()->value(), 20);
+  EXPECT_EQ(tree.root()->color, bst::BLACK);
+}
@@ -0,0 +1,104 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <random>
+#include <set>
+
+/**
+ * @return the size of the given subtree, checking that every node
+ * stores the number of nodes of its subtree.
+ */
+template <typename Node>
+static size_t checked_size_of(const Node* node) {
+  if (!node) {
+    return (0);
+  }
+  auto size = 1 + checked_size_of(node->left) + checked_size_of(node->right);
+  EXPECT_EQ(node->size, size);
+  return (size);
+}
+
+/**
+ * @brief Inserts and removes random values, checking the order
+ * statistics of the tree against a reference set.
+ */
+template <typename Tree>
+static void check_against_reference() {
+  auto tree = Tree();
+  auto reference = std::set<int>();
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(0, 999);
+
+  for (int i = 0; i < 2000; ++i) {
+    auto value = distribution(engine);
+
+    if (i % 3 == 2) {
+      tree.remove(value);
+      reference.erase(value);
+    } else {
+      tree.insert(value);
+      reference.insert(value);
+    }
+  }
+  EXPECT_EQ(checked_size_of(tree.root()), reference.size());
+
+  // Every value is selected by its rank.
+  auto sorted = std::vector<int>(reference.begin(), reference.end());
+  for (size_t k = 0; k < sorted.size(); ++k) {
+    EXPECT_EQ(tree.select(k)->value(), sorted[k]);
+    EXPECT_EQ(tree.rank(sorted[k]), k);
+  }
+  EXPECT_EQ(tree.select(sorted.size()), nullptr);
+
+  // Ranges are counted with inclusive bounds.
+  for (int lo = -10; lo < 1010; lo += 37) {
+    auto hi = lo + 100;
+    auto expected = std::distance(reference.lower_bound(lo), reference.upper_bound(hi));
+    EXPECT_EQ(tree.count_range(lo, hi), (size_t) expected);
+  }
+}
+
+TEST(ORDER_STATISTICS, SELECT_AND_RANK) {
+  // Creating a new order-statistic tree.
+  auto tree = bst::order_statistic_tree_t<int>();
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+
+  EXPECT_EQ(tree.select(0)->value(), 10);
+  EXPECT_EQ(tree.select(3)->value(), 50);
+  EXPECT_EQ(tree.select(7)->value(), 100);
+  EXPECT_EQ(tree.select(8), nullptr);
+
+  // Values absent from the tree can be ranked.
+  EXPECT_EQ(tree.rank(10), (size_t) 0);
+  EXPECT_EQ(tree.rank(55), (size_t) 4);
+  EXPECT_EQ(tree.rank(1000), (size_t) 8);
+}
+
+TEST(ORDER_STATISTICS, COUNT_RANGE) {
+  // Creating a new order-statistic tree.
+  auto tree = bst::order_statistic_tree_t<int>();
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+
+  EXPECT_EQ(tree.count_range(20, 60), (size_t) 4);
+  EXPECT_EQ(tree.count_range(21, 59), (size_t) 2);
+  EXPECT_EQ(tree.count_range(0, 1000), (size_t) 8);
+  EXPECT_EQ(tree.count_range(60, 20), (size_t) 0);
+}
+
+TEST(ORDER_STATISTICS, BALANCING_POLICIES) {
+  check_against_reference<bst::tree_t<int, bst::order_statistic_t<>>>();
+  check_against_reference<bst::order_statistic_tree_t<int, bst::red_black_t>>();
+  check_against_reference<bst::order_statistic_tree_t<int, bst::avl_t>>();
+}
+
+TEST(ORDER_STATISTICS, CLEAR_SUBTREE) {
+  // Creating a new order-statistic tree.
+  auto tree = bst::tree_t<int, bst::order_statistic_t<>>();
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+
+  // Clearing a subtree updates the size of its ancestors.
+  tree.clear(const_cast<bst::node_t<int, bst::order_statistic_t<>::metadata_t>*>(tree.root()->right->right));
+  EXPECT_EQ(checked_size_of(tree.root()), (size_t) 6);
+  EXPECT_EQ(tree.select(5)->value(), 70);
+}
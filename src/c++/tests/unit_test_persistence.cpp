@@ -0,0 +1,239 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The number of values inserted in the trees.
+ */
+static const int iterations = 10000;
+
+/**
+ * @brief A value counting its live instances, whose copies
+ * throw once a given number of copies were made.
+ */
+struct tracked_t {
+  static int instances;
+  static int copies;
+
+  tracked_t(int value): value{value} { ++instances; }
+  tracked_t(const tracked_t& other): value{other.value} {
+    if (copies-- == 0) {
+      throw std::runtime_error("copy");
+    }
+    ++instances;
+  }
+  ~tracked_t() { --instances; }
+
+  bool operator<(const tracked_t& other) const {
+    return (this->value < other.value);
+  }
+
+  int value;
+};
+
+int tracked_t::instances = 0;
+int tracked_t::copies = -1;
+
+/**
+ * @brief Verifies that the given tree holds the given values,
+ * and that its height is the one of an AVL tree.
+ */
+template <typename Tree>
+static void expect_balanced(const Tree& tree, const std::set<int>& expected) {
+  expect_values(tree, expected);
+  EXPECT_LE(tree.stats().height, (size_t) std::ceil(1.45 * std::log2(expected.size() + 2)));
+}
+
+TEST(PERSISTENCE, INSERTION_AND_REMOVAL) {
+  auto tree = bst::persistent_tree_t<int>();
+  auto expected = std::set<int>();
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(0, iterations - 1);
+
+  // Mirroring random insertions and removals in a set.
+  for (int i = 0; i < iterations; ++i) {
+    int value = distribution(engine);
+    if (i % 3) {
+      EXPECT_EQ(tree.insert(value), expected.insert(value).second);
+    } else {
+      EXPECT_EQ(tree.remove(value), expected.erase(value) == 1);
+    }
+    EXPECT_EQ(tree.contains(value), expected.count(value) == 1);
+  }
+  expect_balanced(tree, expected);
+
+  // Sorted insertions keep the tree balanced.
+  tree.clear();
+  expected.clear();
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert(i);
+    expected.insert(i);
+  }
+  expect_balanced(tree, expected);
+  EXPECT_EQ(*tree.find(42), 42);
+  EXPECT_EQ(tree.find(iterations), nullptr);
+}
+
+TEST(PERSISTENCE, SNAPSHOTS) {
+  auto tree = bst::persistent_tree_t<int>();
+  auto expected = std::set<int>();
+  auto snapshots = std::vector<bst::persistent_tree_t<int>>();
+  auto versions = std::vector<std::set<int>>();
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(0, 999);
+
+  // Taking a snapshot after every mutation.
+  for (int i = 0; i < 2000; ++i) {
+    int value = distribution(engine);
+    if (i % 4) {
+      tree.insert(value);
+      expected.insert(value);
+    } else {
+      tree.remove(value);
+      expected.erase(value);
+    }
+    snapshots.push_back(tree.snapshot());
+    versions.push_back(expected);
+    EXPECT_TRUE(snapshots.back().shares(tree));
+  }
+
+  // Later mutations leave the snapshots untouched.
+  tree.clear();
+  EXPECT_TRUE(tree.empty());
+  for (size_t i = 0; i < snapshots.size(); i += 7) {
+    expect_balanced(snapshots[i], versions[i]);
+  }
+
+  // Mutating a snapshot does not affect the other versions.
+  auto copy = snapshots.back();
+  copy.insert(1000);
+  EXPECT_FALSE(copy.shares(snapshots.back()));
+  EXPECT_FALSE(snapshots.back().contains(1000));
+  expect_balanced(snapshots.back(), versions.back());
+}
+
+TEST(PERSISTENCE, MOVE) {
+  // Moving does not throw, unless copying the options does.
+  using type_erased_t = bst::persistent_tree_t<int, bst::options_t<int>>;
+  static_assert(std::is_nothrow_move_constructible_v<bst::persistent_tree_t<int>>);
+  static_assert(std::is_nothrow_move_assignable_v<bst::persistent_tree_t<int>>);
+  static_assert(!std::is_nothrow_move_constructible_v<type_erased_t>);
+  static_assert(!std::is_nothrow_move_assignable_v<type_erased_t>);
+
+  auto tree = bst::persistent_tree_t<int>();
+  tree.insert(1);
+  tree.insert(2);
+
+  auto moved = std::move(tree);
+  EXPECT_EQ(moved.size(), (size_t) 2);
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_FALSE(tree.contains(1));
+}
+
+TEST(PERSISTENCE, STRUCTURAL_SHARING) {
+  {
+    auto tree = bst::persistent_tree_t<tracked_t>();
+    for (int i = 0; i < iterations; ++i) {
+      tree.insert(tracked_t(i));
+    }
+    EXPECT_EQ(tracked_t::instances, iterations);
+
+    // A snapshot shares every node, and a mutation only copies a path.
+    auto snapshot = tree.snapshot();
+    EXPECT_EQ(tracked_t::instances, iterations);
+    tree.insert(tracked_t(iterations));
+    tree.remove(tracked_t(0));
+    EXPECT_LE(tracked_t::instances, iterations + 1 + 4 * (int) tree.stats().height);
+
+    // Releasing the snapshot destroys the nodes it was the only one to reference.
+    snapshot = bst::persistent_tree_t<tracked_t>();
+    EXPECT_EQ(tracked_t::instances, iterations);
+    EXPECT_EQ(tree.find(tracked_t(iterations))->value, iterations);
+  }
+  EXPECT_EQ(tracked_t::instances, 0);
+}
+
+TEST(PERSISTENCE, EXCEPTION_SAFETY) {
+  {
+    auto tree = bst::persistent_tree_t<tracked_t>();
+    for (int i = 0; i < 1000; ++i) {
+      tree.insert(tracked_t(2 * i));
+    }
+    auto snapshot = tree.snapshot();
+
+    // Copying a path throws at every depth, leaving the tree untouched.
+    for (int copies = 0; copies < 3 * (int) tree.stats().height; ++copies) {
+      for (int value : {2 * copies + 1, 2 * copies}) {
+        auto size = tree.size();
+        auto thrown = false;
+
+        tracked_t::copies = copies;
+        try {
+          value % 2 ? tree.insert(tracked_t(value)) : tree.remove(tracked_t(value));
+        } catch (const std::runtime_error&) {
+          thrown = true;
+        }
+        tracked_t::copies = -1;
+        EXPECT_EQ(tree.size(), thrown ? size : value % 2 ? size + 1 : size - 1);
+        EXPECT_EQ(tree.contains(tracked_t(value)), thrown != (value % 2 == 1));
+        EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+      }
+    }
+    EXPECT_EQ(snapshot.size(), (size_t) 1000);
+  }
+
+  // Nodes created before the exceptions were released.
+  EXPECT_EQ(tracked_t::instances, 0);
+}
+
+TEST(PERSISTENCE, CONCURRENT_READERS) {
+  auto tree = bst::persistent_tree_t<int>();
+  auto published = bst::persistent_tree_t<int>();
+  auto mutex = std::mutex();
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+
+  // Readers iterate the published snapshots while the writer mutates the tree.
+  auto readers = std::vector<std::thread>();
+  for (int i = 0; i < 3; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        bst::persistent_tree_t<int> snapshot;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          snapshot = published;
+        }
+        size_t count = std::distance(snapshot.begin(), snapshot.end());
+        inconsistent += count != snapshot.size();
+        inconsistent += !std::is_sorted(snapshot.begin(), snapshot.end());
+      }
+    });
+  }
+
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert((i * 7919) % iterations);
+    if (i % 2) {
+      tree.remove((i * 7919) % iterations / 2);
+    }
+    if (i % 16 == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      published = tree.snapshot();
+    }
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(inconsistent.load(), 0);
+}
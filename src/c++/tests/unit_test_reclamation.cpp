@@ -0,0 +1,210 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * The number of threads accessing the trees.
+ */
+static const int threads = 4;
+
+/**
+ * The number of values handled by the trees.
+ */
+static const int iterations = 10000;
+
+/**
+ * @brief A value counting its live instances.
+ */
+struct counted_t {
+  static std::atomic<int> instances;
+
+  counted_t(int value): value{value} { ++instances; }
+  counted_t(const counted_t& other): value{other.value} { ++instances; }
+  ~counted_t() { --instances; }
+
+  bool operator<(const counted_t& other) const {
+    return (this->value < other.value);
+  }
+
+  int value;
+};
+
+std::atomic<int> counted_t::instances{0};
+
+/**
+ * @brief Inserts and removes counted values from a tree reclaiming
+ * its nodes in a dedicated domain.
+ */
+template <typename Tree>
+static void check_tree_reclamation() {
+  {
+    auto domain = bst::epoch_domain_t(16);
+    auto tree = Tree(bst::default_options_t<counted_t>(), domain);
+
+    // Removed values are reclaimed while the tree is being used.
+    for (int i = 0; i < iterations; ++i) {
+      tree.insert(counted_t((i * 7919) % iterations));
+    }
+    EXPECT_GE(counted_t::instances.load(), iterations);
+    for (int i = 0; i < iterations; ++i) {
+      EXPECT_TRUE(tree.remove(counted_t(i)));
+    }
+    domain.collect();
+    domain.collect();
+    EXPECT_EQ(counted_t::instances.load(), 0);
+
+    // Values removed concurrently are reclaimed at the latest with the domain.
+    run_threads(threads, [&] (int thread) {
+      for (int i = thread; i < iterations; i += threads) {
+        tree.insert(counted_t(i));
+        tree.remove(counted_t(i));
+      }
+    });
+    EXPECT_TRUE(tree.empty());
+  }
+  EXPECT_EQ(counted_t::instances.load(), 0);
+}
+
+TEST(RECLAMATION, DEFERRED_DESTRUCTION) {
+  auto domain = bst::epoch_domain_t(1);
+  std::promise<void> pinned, unpin;
+
+  // A thread pinned before the object is retired prevents its destruction.
+  auto reader = std::thread([&] {
+    auto guard = domain.pin();
+    pinned.set_value();
+    unpin.get_future().wait();
+  });
+  pinned.get_future().wait();
+  domain.retire(new counted_t(1));
+  domain.collect();
+  domain.collect();
+  EXPECT_EQ(counted_t::instances.load(), 1);
+
+  // The object is destroyed once the epoch advanced twice.
+  unpin.set_value();
+  reader.join();
+  domain.collect();
+  EXPECT_EQ(counted_t::instances.load(), 0);
+}
+
+TEST(RECLAMATION, NESTED_GUARDS) {
+  auto domain = bst::epoch_domain_t(1);
+
+  {
+    auto outer = domain.pin();
+    {
+      auto inner = domain.pin();
+      domain.retire(new counted_t(1));
+    }
+    // The thread is still pinned by the outer guard.
+    domain.collect();
+    domain.collect();
+    EXPECT_EQ(counted_t::instances.load(), 1);
+  }
+  domain.collect();
+  EXPECT_EQ(counted_t::instances.load(), 0);
+}
+
+TEST(RECLAMATION, BATCHED_RECLAMATION) {
+  auto domain = bst::epoch_domain_t(8);
+
+  // Retired objects are reclaimed every 8 retirements.
+  for (int i = 0; i < iterations; ++i) {
+    domain.retire(new counted_t(i));
+    EXPECT_LE(counted_t::instances.load(), 3 * 8);
+  }
+  domain.collect();
+  domain.collect();
+  EXPECT_EQ(counted_t::instances.load(), 0);
+}
+
+TEST(RECLAMATION, THREAD_EXIT) {
+  {
+    auto domain = bst::epoch_domain_t(iterations);
+
+    // Objects retired by exited threads are handed over to the threads
+    // reusing their records, and destroyed with the domain otherwise.
+    for (int i = 0; i < threads; ++i) {
+      std::thread([&] {
+        for (int j = 0; j < 10; ++j) {
+          domain.retire(new counted_t(j));
+        }
+      }).join();
+    }
+    EXPECT_EQ(counted_t::instances.load(), 10 * threads);
+  }
+  EXPECT_EQ(counted_t::instances.load(), 0);
+}
+
+TEST(RECLAMATION, CONCURRENT_TREE) {
+  check_tree_reclamation<bst::concurrent_tree_t<counted_t>>();
+}
+
+TEST(RECLAMATION, LOCK_FREE_TREE) {
+  check_tree_reclamation<bst::lock_free_tree_t<counted_t>>();
+}
+
+TEST(RECLAMATION, REMOVALS_UNDER_TRAVERSAL) {
+  auto domain = bst::epoch_domain_t();
+  auto tree = bst::red_black_tree_t<int>();
+  auto mutex = std::shared_mutex();
+  std::atomic<bool> done{false};
+  std::atomic<int> corrupted{0};
+
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+  tree.insert(values.begin(), values.end());
+
+  // Readers collect the values of the tree while holding the lock, and read
+  // them again once the writer may have removed them, which would find
+  // other values in reallocated nodes if they were destroyed.
+  auto readers = std::vector<std::thread>();
+  for (int i = 0; i < threads - 1; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        auto guard = domain.pin();
+        std::vector<std::pair<const int*, int>> seen;
+        {
+          std::shared_lock<std::shared_mutex> lock(mutex);
+          for (auto it = tree.begin(); it != tree.end() && seen.size() < 256; ++it) {
+            seen.emplace_back(&*it, *it);
+          }
+        }
+        std::this_thread::yield();
+        for (auto [address, value] : seen) {
+          corrupted += *address != value;
+        }
+      }
+    });
+  }
+
+  // The writer removes every value, reinserting it, and finally clears the tree.
+  for (int round = 0; round < 2; ++round) {
+    for (auto value : values) {
+      std::unique_lock<std::shared_mutex> lock(mutex);
+      tree.remove(value, domain);
+      tree.insert(value + (round + 1) * iterations);
+    }
+  }
+  {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    tree.clear(domain);
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(corrupted.load(), 0);
+  EXPECT_EQ(tree.size(), (size_t) 0);
+}
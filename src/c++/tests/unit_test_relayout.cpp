@@ -0,0 +1,176 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Serializes the shape of the given subtree, verifying its parent links.
+ * @param node the root of the subtree.
+ * @param shape the serialized values of the subtree in pre-order,
+ * a missing child being serialized as "-".
+ * @return whether the parent links of the subtree are consistent.
+ */
+template <typename Node>
+static bool shape_of(const Node* node, std::string& shape) {
+  if (!node) {
+    shape += "- ";
+    return (true);
+  }
+  shape += std::to_string(node->value()) + " ";
+  if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    return (false);
+  return (shape_of(node->left, shape) && shape_of(node->right, shape));
+}
+
+/**
+ * @brief Relayouts a tree holding shuffled values, part of which were
+ * removed, verifying that its values and its shape are preserved, and
+ * that the tree can still be mutated, with the given check function.
+ */
+template <typename Tree, typename Check>
+static void check_relayout(Check&& check) {
+  for (int size : {0, 1, 2, 3, 100, 5000}) {
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+    auto tree = Tree();
+    tree.insert(values.begin(), values.end());
+    for (int i = 0; i < size; i += 3) {
+      tree.remove(values[i]);
+    }
+    std::vector<int> expected(tree.begin(), tree.end());
+    std::string before, after;
+    ASSERT_TRUE(shape_of(tree.root(), before));
+
+    tree.relayout();
+    ASSERT_TRUE(shape_of(tree.root(), after));
+    EXPECT_EQ(before, after);
+    EXPECT_EQ(tree.size(), expected.size());
+    EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+    if (tree.root()) {
+      EXPECT_EQ(tree.root()->parent, nullptr);
+    }
+    check(tree);
+
+    // The tree can still be mutated.
+    for (int i = 0; i < size; i += 3) {
+      tree.insert(values[i]);
+    }
+    for (int i = 1; i < size; i += 3) {
+      tree.remove(values[i]);
+    }
+    EXPECT_EQ(tree.size(), (size_t) (size - (size + 1) / 3));
+    EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+    check(tree);
+  }
+}
+
+TEST(RELAYOUT, UNBALANCED) {
+  check_relayout<bst::tree_t<int>>([] (const auto&) {});
+}
+
+TEST(RELAYOUT, RED_BLACK) {
+  check_relayout<bst::red_black_tree_t<int>>([] (const auto& tree) {
+    if (tree.root()) {
+      EXPECT_EQ(tree.root()->color, bst::BLACK);
+    }
+  });
+}
+
+TEST(RELAYOUT, AVL) {
+  check_relayout<bst::avl_tree_t<int>>([] (const auto& tree) {
+    EXPECT_LE(tree.stats().height, (size_t) (1.45 * std::log2(tree.size() + 2)));
+  });
+}
+
+TEST(RELAYOUT, ORDER_STATISTIC) {
+  check_relayout<bst::order_statistic_tree_t<int>>([] (const auto& tree) {
+    for (size_t k = 0; k < tree.size(); k += 97) {
+      EXPECT_EQ(tree.rank(tree.select(k)->value()), k);
+    }
+  });
+}
+
+TEST(RELAYOUT, VAN_EMDE_BOAS_ORDER) {
+  // The nodes of a complete tree of height 4 allocated from an arena are laid
+  // out as its top 2 levels, followed by its 4 bottom subtrees of height 2.
+  auto tree = bst::arena_tree_t<int, bst::red_black_t>();
+  std::vector<int> values(15);
+  std::iota(values.begin(), values.end(), 1);
+  tree.build_from_sorted(values.begin(), values.end());
+
+  tree.relayout();
+  std::vector<uintptr_t> addresses;
+  for (int value : {8, 4, 12, 2, 1, 3, 6, 5, 7, 10, 9, 11, 14, 13, 15}) {
+    addresses.push_back(reinterpret_cast<uintptr_t>(std::as_const(tree).find(value).value()));
+  }
+  // The nodes are allocated as a single contiguous block.
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(tree.root()), addresses.front());
+  for (size_t i = 1; i < addresses.size(); ++i) {
+    EXPECT_EQ(addresses[i] - addresses[i - 1], sizeof(*tree.root()));
+  }
+}
+
+TEST(RELAYOUT, ARENA) {
+  // Every relayout moves the nodes to a new arena, releasing the previous one.
+  check_relayout<bst::arena_tree_t<int, bst::red_black_t>>([] (auto& tree) {
+    tree.relayout();
+    tree.relayout();
+  });
+}
+
+/**
+ * @brief A value whose copies throw after a given number of copies,
+ * and whose move constructor may throw, so that it is copied.
+ */
+struct throwing_t {
+  static int copies;
+  int value;
+
+  throwing_t(int value): value(value) {}
+
+  throwing_t(const throwing_t& other): value(other.value) {
+    if (copies-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+
+  throwing_t(throwing_t&& other): value(other.value) {}
+
+  bool operator<(const throwing_t& other) const {
+    return (this->value < other.value);
+  }
+};
+
+int throwing_t::copies = -1;
+
+TEST(RELAYOUT, EXCEPTION_SAFETY) {
+  auto tree = bst::red_black_tree_t<throwing_t>();
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(throwing_t(i));
+  }
+  auto root = tree.root();
+
+  // The tree is left untouched when a copy throws.
+  throwing_t::copies = 50;
+  EXPECT_THROW(tree.relayout(), std::runtime_error);
+  EXPECT_EQ(tree.root(), root);
+  EXPECT_EQ(tree.size(), (size_t) 100);
+  int expected = 0;
+  for (const auto& value : tree) {
+    EXPECT_EQ(value.value, expected++);
+  }
+
+  throwing_t::copies = -1;
+  tree.relayout();
+  EXPECT_NE(tree.root(), root);
+  EXPECT_EQ(tree.size(), (size_t) 100);
+}
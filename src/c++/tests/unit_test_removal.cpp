@@ -0,0 +1,70 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+/** The tree must be layed-out acccording to the following structure. */
+/**                        50                                          */
+/**                       /  \                                         */
+/**                     20     70                                      */
+/**                    /  \   /  \                                     */
+/**                  10   40 60  90                                    */
+/**                               \                                    */
+/**                                100                                 */
+
+TEST(REMOVAL, OF_SPECIFIC_NODE) {
+  // Creating a new binary search tree.
+  auto tree = bst::tree_t<int>();
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+
+  // Removing a node with two children returns its successor.
+  auto root = const_cast<bst::node_t<int>*>(tree.root());
+  auto successor = tree.remove(root, 50);
+  EXPECT_EQ(successor->value(), 60);
+  EXPECT_EQ(tree.root()->value(), 60);
+  EXPECT_EQ(tree.size(), (size_t) 7);
+
+  // Removing the largest node has no successor.
+  EXPECT_EQ(tree.remove(const_cast<bst::node_t<int>*>(tree.root()), 100), nullptr);
+  EXPECT_FALSE(tree.find(100).has_value());
+  EXPECT_EQ(tree.max()->value(), 90);
+}
+
+TEST(REMOVAL, OF_SUBTREE) {
+  // Creating a new binary search tree.
+  auto tree = bst::tree_t<int>();
+  tree.insert(50, 70, 60, 20, 90, 10, 40, 100);
+
+  // Clearing the right subtree.
+  tree.clear(const_cast<bst::node_t<int>*>(tree.root()->right));
+  EXPECT_EQ(tree.size(), (size_t) 4);
+  EXPECT_EQ(tree.root()->right, nullptr);
+  EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>({ 10, 20, 40, 50 }));
+
+  // Clearing the whole tree.
+  tree.clear();
+  EXPECT_EQ(tree.size(), (size_t) 0);
+  EXPECT_EQ(tree.root(), nullptr);
+}
+
+TEST(REMOVAL, OF_DEGENERATE_TREE) {
+  // Creating a new unbalanced binary search tree.
+  auto tree = bst::tree_t<int>();
+
+  // Inserting sorted values degrades the tree into a list.
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert(i);
+  }
+  EXPECT_FALSE(tree.to_string().empty());
+  EXPECT_TRUE(tree.find(4999).has_value());
+
+  // Removing every other value.
+  for (int i = 0; i < 5000; i += 2) {
+    tree.remove(i);
+  }
+  EXPECT_EQ(tree.size(), (size_t) 2500);
+  EXPECT_EQ(tree.min()->value(), 1);
+  tree.clear();
+  EXPECT_EQ(tree.size(), (size_t) 0);
+}
@@ -1,6 +1,12 @@
 #include <binary_search_tree.hpp>
 #include <gtest/gtest.h>
 #include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
 
 /**
  * @brief A helper function used to construct an array at compile-time.
@@ -77,3 +83,87 @@ TEST(SEARCH, MAX_NODE) {
   EXPECT_EQ(tree.max()->value(), data[7]);
   EXPECT_EQ(tree.max(tree.root())->value(), data[7]);
 }
+
+/**
+ * @brief Verifies that batched look-ups of keys, part of which are
+ * missing, yield the same results as single look-ups.
+ */
+template <typename Tree>
+static void check_batched_find() {
+  for (int size : {0, 1, 15, 16, 17, 1000}) {
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+    auto tree = Tree();
+    tree.insert(values.begin(), values.end());
+
+    // Looking up every value, and as many missing values.
+    std::vector<int> keys;
+    for (int i = -size; i < 2 * size + 1; ++i) {
+      keys.push_back(i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine(7));
+
+    std::vector<std::optional<const typename Tree::node_type*>> results(keys.size());
+    auto last = tree.find(keys.begin(), keys.end(), results.data());
+    EXPECT_EQ(last, results.data() + results.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] >= 0 && keys[i] < size) {
+        ASSERT_TRUE(results[i].has_value());
+        EXPECT_EQ((*results[i])->value(), keys[i]);
+        EXPECT_EQ(results[i], std::as_const(tree).find(keys[i]));
+      } else {
+        EXPECT_FALSE(results[i].has_value());
+      }
+    }
+    EXPECT_EQ(tree.size(), (size_t) size);
+    EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+  }
+}
+
+TEST(SEARCH, BATCHED) {
+  check_batched_find<bst::tree_t<int>>();
+  check_batched_find<bst::red_black_tree_t<int>>();
+  check_batched_find<bst::avl_tree_t<int>>();
+}
+
+TEST(SEARCH, BATCHED_SPLAY) {
+  // The last looked-up key is splayed to the root.
+  check_batched_find<bst::splay_tree_t<int>>();
+
+  auto tree = bst::splay_tree_t<int>();
+  for (auto value : data) {
+    tree.insert(value);
+  }
+  auto keys = array_of<int>(10, 55, 90);
+  auto nodes = tree.find(keys.begin(), keys.end());
+
+  ASSERT_EQ(nodes.size(), keys.size());
+  EXPECT_EQ((*nodes[0])->value(), 10);
+  EXPECT_FALSE(nodes[1].has_value());
+  EXPECT_EQ((*nodes[2])->value(), 90);
+  EXPECT_EQ(tree.root()->value(), 90);
+}
+
+TEST(SEARCH, BATCHED_FROM_INPUT_ITERATOR) {
+  // Keys yielded by value are copied before being looked up.
+  auto tree = bst::tree_t<int>();
+  for (auto value : data) {
+    tree.insert(value);
+  }
+
+  std::istringstream stream("10 20 30 40 50 60 70 80 90 100 110 120 130 140 150 160 170 180");
+  auto nodes = tree.find(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+
+  ASSERT_EQ(nodes.size(), (size_t) 18);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    int key = 10 * (i + 1);
+    bool expected = std::find(data.begin(), data.end(), key) != data.end();
+    ASSERT_EQ(nodes[i].has_value(), expected);
+    if (expected) {
+      EXPECT_EQ((*nodes[i])->value(), key);
+    }
+  }
+}
@@ -0,0 +1,193 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * @brief Verifies the parent links of the given subtree.
+ * @param node the root of the subtree.
+ * @return the number of nodes of the subtree, or -1 if a link is inconsistent.
+ */
+template <typename Node>
+static int linked_size_of(const Node* node) {
+  if (!node) return (0);
+
+  if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    return (-1);
+
+  int left  = linked_size_of(node->left);
+  int right = linked_size_of(node->right);
+
+  if (left < 0 || right < 0)
+    return (-1);
+  return (1 + left + right);
+}
+
+/**
+ * @return a set of random values drawn in `[0, range)`.
+ */
+static std::set<int> random_set(size_t count, int range, unsigned seed) {
+  auto engine = std::mt19937(seed);
+  auto distribution = std::uniform_int_distribution<int>(0, range - 1);
+  std::set<int> values;
+
+  while (values.size() < count) {
+    values.insert(distribution(engine));
+  }
+  return (values);
+}
+
+/**
+ * @brief Inserts the given values in the given tree in a random order,
+ * so that unbalanced trees do not degrade into a list.
+ */
+template <typename Tree>
+static void insert_shuffled(Tree& tree, const std::set<int>& values) {
+  std::vector<int> shuffled(values.begin(), values.end());
+  std::shuffle(shuffled.begin(), shuffled.end(), std::default_random_engine(42));
+  tree.insert(shuffled.begin(), shuffled.end());
+}
+
+/**
+ * @brief Verifies that the given tree holds the given values,
+ * and that its nodes are consistently linked.
+ */
+template <typename Tree>
+static void expect_linked(const Tree& tree, const std::vector<int>& expected) {
+  expect_values(tree, expected);
+  EXPECT_EQ(linked_size_of(tree.root()), (int) expected.size());
+  if (tree.root()) {
+    EXPECT_EQ(tree.root()->parent, nullptr);
+  }
+}
+
+/**
+ * @brief Runs the set operations on trees of random values of various
+ * sizes, against `std::set_union`, `std::set_intersection` and
+ * `std::set_difference`, checking the invariants of the results
+ * with the given function.
+ */
+template <typename Tree, typename Check>
+static void check_set_operations(bst::thread_pool_t& pool, Check&& check) {
+  for (auto [lhs_size, rhs_size] : {std::pair(0, 100), std::pair(100, 0), std::pair(5000, 5000), std::pair(20000, 50), std::pair(50, 20000)}) {
+    auto lhs = random_set(lhs_size, 40000, 1);
+    auto rhs = random_set(rhs_size, 40000, 2);
+
+    // Union.
+    {
+      std::vector<int> expected;
+      std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected));
+      auto tree  = Tree();
+      auto other = Tree();
+      insert_shuffled(tree, lhs);
+      insert_shuffled(other, rhs);
+      tree.union_with(std::move(other), pool);
+      expect_linked(tree, expected);
+      expect_linked(other, {});
+      check(tree);
+    }
+
+    // Intersection.
+    {
+      std::vector<int> expected;
+      std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected));
+      auto tree  = Tree();
+      auto other = Tree();
+      insert_shuffled(tree, lhs);
+      insert_shuffled(other, rhs);
+      tree.intersect_with(other, pool);
+      expect_linked(tree, expected);
+      expect_linked(other, std::vector<int>(rhs.begin(), rhs.end()));
+      check(tree);
+    }
+
+    // Difference.
+    {
+      std::vector<int> expected;
+      std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected));
+      auto tree  = Tree();
+      auto other = Tree();
+      insert_shuffled(tree, lhs);
+      insert_shuffled(other, rhs);
+      tree.difference_with(other, pool);
+      expect_linked(tree, expected);
+      expect_linked(other, std::vector<int>(rhs.begin(), rhs.end()));
+      check(tree);
+    }
+  }
+}
+
+TEST(SET_OPERATIONS, UNBALANCED) {
+  auto pool = bst::thread_pool_t(0);
+  check_set_operations<bst::tree_t<int>>(pool, [] (const auto&) {});
+}
+
+TEST(SET_OPERATIONS, RED_BLACK) {
+  auto pool = bst::thread_pool_t(3);
+  check_set_operations<bst::red_black_tree_t<int>>(pool, [] (const auto& tree) {
+    EXPECT_GT(black_height_of(tree.root()), 0);
+    if (tree.root()) {
+      EXPECT_EQ(tree.root()->color, bst::BLACK);
+    }
+  });
+}
+
+TEST(SET_OPERATIONS, AVL) {
+  auto pool = bst::thread_pool_t(3);
+  check_set_operations<bst::avl_tree_t<int>>(pool, [] (const auto& tree) {
+    EXPECT_GE(avl_height_of(tree.root()), 0);
+  });
+}
+
+TEST(SET_OPERATIONS, SCAPEGOAT) {
+  check_set_operations<bst::scapegoat_tree_t<int>>(bst::default_thread_pool(), [] (const auto&) {});
+}
+
+TEST(SET_OPERATIONS, ORDER_STATISTIC) {
+  auto pool = bst::thread_pool_t(2);
+  check_set_operations<bst::order_statistic_tree_t<int>>(pool, [] (const auto& tree) {
+    EXPECT_GT(black_height_of(tree.root()), 0);
+    for (size_t k = 0; k < tree.size(); k += 97) {
+      EXPECT_EQ(tree.rank(tree.select(k)->value()), k);
+    }
+  });
+}
+
+TEST(SET_OPERATIONS, POOLED_UNION) {
+  // Trees sharing a pool resource can be united in parallel.
+  auto resource = std::make_shared<bst::pool_resource_t>();
+  auto allocator = bst::pool_allocator_t<int>(resource);
+  using tree_type = bst::tree_t<int, bst::avl_t, bst::default_options_t<int>, bst::pool_allocator_t<int>>;
+  auto tree  = tree_type(bst::default_options_t<int>(), allocator);
+  auto other = tree_type(bst::default_options_t<int>(), allocator);
+
+  for (int i = 0; i < 10000; ++i) {
+    (i % 3 ? tree : other).insert(i);
+    if (i % 5 == 0) other.insert(i);
+  }
+  tree.union_with(std::move(other));
+  EXPECT_EQ(tree.size(), (size_t) 10000);
+  EXPECT_GE(avl_height_of(tree.root()), 0);
+
+  // Trees using different resources cannot be united.
+  auto foreign = tree_type();
+  foreign.insert(10000);
+  EXPECT_THROW(tree.union_with(std::move(foreign)), std::invalid_argument);
+  EXPECT_EQ(foreign.size(), (size_t) 1);
+}
+
+TEST(SET_OPERATIONS, SELF) {
+  auto tree = bst::red_black_tree_t<int>();
+  tree.insert(1, 2, 3);
+
+  tree.union_with(std::move(tree));
+  tree.intersect_with(tree);
+  EXPECT_EQ(tree.size(), (size_t) 3);
+  tree.difference_with(tree);
+  EXPECT_EQ(tree.size(), (size_t) 0);
+}
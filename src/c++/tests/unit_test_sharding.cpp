@@ -0,0 +1,133 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * The number of threads accessing the trees.
+ */
+static const int threads = 4;
+
+/**
+ * The number of values handled by each thread.
+ */
+static const int iterations = 10000;
+
+/**
+ * @return the values of the given tree, in the order they are visited.
+ */
+template <typename Tree>
+static std::vector<typename Tree::value_type> values_of(const Tree& tree) {
+  std::vector<typename Tree::value_type> values;
+  tree.for_each([&] (const auto& value) { values.push_back(value); });
+  return (values);
+}
+
+TEST(SHARDING, ROUTING) {
+  auto tree = bst::sharded_tree_t<int>({100, 200, 300});
+  auto expected = std::set<int>();
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<int>(-100, 499);
+
+  // Mirroring random insertions and removals in a set.
+  for (int i = 0; i < iterations; ++i) {
+    int value = distribution(engine);
+    if (i % 3) {
+      EXPECT_EQ(tree.insert(value), expected.insert(value).second);
+    } else {
+      EXPECT_EQ(tree.remove(value), expected.erase(value) == 1);
+    }
+    EXPECT_EQ(tree.contains(value), expected.count(value) == 1);
+  }
+  EXPECT_EQ(tree.size(), expected.size());
+  EXPECT_EQ(values_of(tree), std::vector<int>(expected.begin(), expected.end()));
+  EXPECT_EQ(tree.find(*expected.begin()).value(), *expected.begin());
+
+  // Every shard holds its range of values.
+  auto sizes = tree.shard_sizes();
+  ASSERT_EQ(sizes.size(), (size_t) 4);
+  EXPECT_EQ(sizes[0], (size_t) std::distance(expected.begin(), expected.lower_bound(100)));
+  EXPECT_EQ(sizes[3], (size_t) std::distance(expected.lower_bound(300), expected.end()));
+}
+
+TEST(SHARDING, INVALID_SPLIT_POINTS) {
+  EXPECT_THROW(bst::sharded_tree_t<int>({2, 1}), std::invalid_argument);
+  EXPECT_THROW(bst::sharded_tree_t<int>({1, 1}), std::invalid_argument);
+
+  // A tree without split points has a single shard.
+  auto tree = bst::sharded_tree_t<int>({});
+  tree.insert(1);
+  EXPECT_EQ(tree.shard_sizes(), std::vector<size_t>{1});
+  EXPECT_FALSE(tree.rebalance());
+}
+
+TEST(SHARDING, REBALANCING) {
+  auto tree = bst::sharded_tree_t<int, bst::avl_t>({1000, 2000, 3000});
+
+  // Every value lands in the last shard, which grows hot.
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert(3000 + i);
+  }
+  EXPECT_EQ(tree.shard_sizes(), (std::vector<size_t>{0, 0, 0, (size_t) iterations}));
+  EXPECT_TRUE(tree.rebalance());
+
+  // The split points move to the quartiles.
+  EXPECT_EQ(tree.split_points(), (std::vector<int>{3000 + iterations / 4, 3000 + iterations / 2, 3000 + 3 * iterations / 4}));
+  EXPECT_EQ(tree.shard_sizes(), (std::vector<size_t>(4, iterations / 4)));
+  EXPECT_FALSE(tree.rebalance());
+
+  std::vector<int> expected(iterations);
+  std::iota(expected.begin(), expected.end(), 3000);
+  EXPECT_EQ(values_of(tree), expected);
+  for (int i = 0; i < iterations; i += 97) {
+    EXPECT_TRUE(tree.contains(3000 + i));
+  }
+  EXPECT_TRUE(tree.insert(0));
+  EXPECT_EQ(tree.shard_sizes()[0], (size_t) iterations / 4 + 1);
+}
+
+TEST(SHARDING, CONCURRENT_WRITERS_AND_REBALANCING) {
+  auto tree = bst::sharded_tree_t<int>({iterations / 2});
+  std::atomic<bool> done{false};
+  std::atomic<int> missing{0};
+
+  // A thread keeps rebalancing the shards while writers insert
+  // skewed values and readers look them up.
+  auto rebalancer = std::thread([&] {
+    while (!done) {
+      tree.rebalance(1.2);
+      std::this_thread::yield();
+    }
+  });
+
+  std::vector<std::thread> workers;
+  for (int thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&, thread] {
+      for (int i = thread; i < threads * iterations; i += threads) {
+        int value = i * i % (threads * iterations);
+        tree.insert(value);
+        missing += !tree.contains(value);
+        if (i % 4 == 0) {
+          tree.remove(value);
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  done = true;
+  rebalancer.join();
+
+  // Values inserted by a thread are found by the same thread, whichever shard they moved to.
+  EXPECT_EQ(missing.load(), 0);
+  auto values = values_of(tree);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_EQ(values.size(), tree.size());
+}
@@ -0,0 +1,188 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include "tree_invariants.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <utility>
+
+/**
+ * The number of values to insert in the trees.
+ */
+static const int iterations = 10000;
+
+/**
+ * @brief Verifies the parent links of the given subtree.
+ * @param node the root of the subtree.
+ * @return the height of the subtree, or -1 if a link is inconsistent.
+ */
+template <typename Node>
+static int linked_height_of(const Node* node) {
+  if (!node) return (0);
+
+  if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    return (-1);
+
+  int left  = linked_height_of(node->left);
+  int right = linked_height_of(node->right);
+
+  if (left < 0 || right < 0)
+    return (-1);
+  return (1 + std::max(left, right));
+}
+
+/**
+ * @brief Verifies that the given tree holds the values of the
+ * given range, and that its nodes are consistently linked.
+ */
+template <typename Tree>
+static void expect_range(const Tree& tree, int begin, int end) {
+  std::vector<int> expected(std::max(end - begin, 0));
+  std::iota(expected.begin(), expected.end(), begin);
+
+  expect_values(tree, expected);
+  EXPECT_GE(linked_height_of(tree.root()), 0);
+  if (tree.root()) {
+    EXPECT_EQ(tree.root()->parent, nullptr);
+  }
+}
+
+/**
+ * @brief Splits a tree holding shuffled values around several keys,
+ * and joins the parts back, checking the invariants of the trees
+ * with the given function.
+ */
+template <typename Tree, typename Check>
+static void split_and_join(Check&& check) {
+  std::vector<int> values(iterations);
+  std::iota(values.begin(), values.end(), 0);
+  std::shuffle(values.begin(), values.end(), std::default_random_engine(42));
+
+  for (int key : {-1, 0, 1, iterations / 3, iterations / 2, iterations - 1, iterations, iterations + 1}) {
+    auto tree = Tree();
+    tree.insert(values.begin(), values.end());
+    auto node = tree.find(iterations / 2).value();
+
+    // Splitting the tree around the key.
+    auto [lower, upper] = tree.split(key);
+    auto split = std::clamp(key, 0, iterations);
+
+    EXPECT_EQ(tree.size(), (size_t) 0);
+    EXPECT_EQ(tree.root(), nullptr);
+    expect_range(lower, 0, split);
+    expect_range(upper, split, iterations);
+    check(lower);
+    check(upper);
+
+    // Joining the parts back, without reallocating the nodes.
+    auto joined = bst::join(std::move(lower), std::move(upper));
+
+    EXPECT_EQ(lower.size(), (size_t) 0);
+    EXPECT_EQ(upper.size(), (size_t) 0);
+    expect_range(joined, 0, iterations);
+    check(joined);
+    EXPECT_EQ(std::as_const(joined).find(iterations / 2).value(), node);
+  }
+}
+
+TEST(SPLIT_JOIN, UNBALANCED) {
+  split_and_join<bst::tree_t<int>>([] (const auto&) {});
+}
+
+TEST(SPLIT_JOIN, RED_BLACK) {
+  split_and_join<bst::red_black_tree_t<int>>([] (const auto& tree) {
+    EXPECT_GT(black_height_of(tree.root()), 0);
+    if (tree.root()) {
+      EXPECT_EQ(tree.root()->color, bst::BLACK);
+    }
+  });
+}
+
+TEST(SPLIT_JOIN, AVL) {
+  split_and_join<bst::avl_tree_t<int>>([] (const auto& tree) {
+    EXPECT_GE(avl_height_of(tree.root()), 0);
+  });
+}
+
+TEST(SPLIT_JOIN, SCAPEGOAT) {
+  split_and_join<bst::scapegoat_tree_t<int>>([] (const auto&) {});
+}
+
+TEST(SPLIT_JOIN, SPLAY) {
+  split_and_join<bst::splay_tree_t<int>>([] (const auto&) {});
+}
+
+TEST(SPLIT_JOIN, ORDER_STATISTIC) {
+  split_and_join<bst::order_statistic_tree_t<int, bst::avl_t>>([] (const auto& tree) {
+    EXPECT_GE(avl_height_of(tree.root()), 0);
+    for (size_t k = 0; k < tree.size(); k += 97) {
+      EXPECT_EQ(tree.rank(tree.select(k)->value()), k);
+    }
+  });
+}
+
+TEST(SPLIT_JOIN, UNEVEN_JOIN) {
+  // Joining a large tree with a single value, on both sides.
+  auto tree = bst::red_black_tree_t<int>();
+  for (int i = 1; i < iterations; ++i) {
+    tree.insert(i);
+  }
+
+  auto smallest = bst::red_black_tree_t<int>();
+  smallest.insert(0);
+  auto largest = bst::red_black_tree_t<int>();
+  largest.insert(iterations);
+
+  smallest.join(std::move(tree));
+  smallest.join(std::move(largest));
+  expect_range(smallest, 0, iterations + 1);
+  EXPECT_GT(black_height_of(smallest.root()), 0);
+  EXPECT_LE(smallest.stats().height, (size_t) (2 * std::log2(iterations + 2)));
+}
+
+TEST(SPLIT_JOIN, OVERLAPPING_JOIN) {
+  auto lower = bst::avl_tree_t<int>();
+  auto upper = bst::avl_tree_t<int>();
+  lower.insert(1, 2, 3);
+  upper.insert(3, 4, 5);
+
+  // Overlapping trees are left untouched.
+  EXPECT_THROW(lower.join(std::move(upper)), std::invalid_argument);
+  expect_range(lower, 1, 4);
+  expect_range(upper, 3, 6);
+
+  // Joining with an empty tree moves the other tree.
+  auto empty = bst::avl_tree_t<int>();
+  empty.join(std::move(upper));
+  expect_range(empty, 3, 6);
+  expect_range(upper, 0, 0);
+}
+
+/**
+ * @brief Mutates the parts of a split tree, and joins them back.
+ */
+template <typename Tree>
+static void split_mutate_and_join() {
+  auto tree = Tree();
+  for (int i = 0; i < iterations; ++i) {
+    tree.insert(i);
+  }
+  auto [lower, upper] = tree.split(iterations / 2);
+
+  // The sizes counted by the split account for the mutations.
+  lower.insert(-1);
+  lower.remove(0);
+  upper.remove(iterations - 1);
+  upper.remove(iterations / 2);
+  lower.join(std::move(upper));
+  EXPECT_EQ(lower.size(), (size_t) (iterations - 2));
+  EXPECT_EQ(std::distance(lower.begin(), lower.end()), iterations - 2);
+  EXPECT_TRUE(std::is_sorted(lower.begin(), lower.end()));
+}
+
+TEST(SPLIT_JOIN, SPLIT_SIZE) {
+  split_mutate_and_join<bst::red_black_tree_t<int>>();
+  split_mutate_and_join<bst::scapegoat_tree_t<int>>();
+}
@@ -0,0 +1,82 @@
+#include <binary_search_tree.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Verifies the look-ups of indexes of sets of random integers of
+ * various sizes, including the sizes filling whole levels of nodes,
+ * against the `lower_bound` of the tree the index is built from.
+ */
+template <typename T>
+static void check_static_btree() {
+  auto engine = std::mt19937(42);
+  auto distribution = std::uniform_int_distribution<T>(-1000000, 1000000);
+
+  for (size_t size : {0, 1, 15, 16, 17, 272, 289, 1000, 4913, 20000}) {
+    auto tree = bst::red_black_tree_t<T>();
+    std::set<T> values;
+
+    while (values.size() < size) {
+      auto value = distribution(engine);
+      values.insert(value);
+      tree.insert(value);
+    }
+    auto index = bst::static_btree_t<T>(tree.begin(), tree.end());
+    EXPECT_EQ(index.size(), size);
+    EXPECT_EQ(index.empty(), size == 0);
+
+    // Looking up the values, their neighbours, and random keys.
+    std::vector<T> keys = {std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    for (auto value : values) {
+      keys.insert(keys.end(), {value - 1, value, value + 1});
+    }
+    for (int i = 0; i < 1000; ++i) {
+      keys.push_back(distribution(engine));
+    }
+
+    for (auto key : keys) {
+      auto expected = values.lower_bound(key);
+      auto value = index.lower_bound(key);
+
+      if (expected == values.end()) {
+        EXPECT_EQ(value, nullptr);
+      } else {
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, *expected);
+      }
+      EXPECT_EQ(index.contains(key), values.count(key) == 1);
+    }
+  }
+}
+
+TEST(STATIC_BTREE, INT32) {
+  check_static_btree<int32_t>();
+}
+
+TEST(STATIC_BTREE, INT64) {
+  check_static_btree<int64_t>();
+}
+
+TEST(STATIC_BTREE, EXTREME_VALUES) {
+  // The greatest integer is told apart from the padding of the nodes.
+  for (auto values : {std::vector<int32_t>{1, 2, 3}, std::vector<int32_t>{1, std::numeric_limits<int32_t>::max()}}) {
+    auto index = bst::static_btree_t<int32_t>(values.begin(), values.end());
+    bool has_max = values.back() == std::numeric_limits<int32_t>::max();
+
+    EXPECT_EQ(index.contains(std::numeric_limits<int32_t>::max()), has_max);
+    EXPECT_EQ(index.lower_bound(4) != nullptr, has_max);
+    EXPECT_EQ(*index.lower_bound(std::numeric_limits<int32_t>::min()), 1);
+  }
+}
+
+TEST(STATIC_BTREE, INSTRUCTION_SET) {
+  auto name = std::string(bst::static_btree_t<int32_t>::instruction_set());
+  EXPECT_TRUE(name == "avx2" || name == "sse2" || name == "scalar");
+  EXPECT_NE(std::string(bst::static_btree_t<int64_t>::instruction_set()), "sse2");
+}
@@ -55,6 +55,8 @@ typedef enum bst_direction_t {
 /**
  * @brief Describes a binary-search tree node
  * attributes.
+ * @note Every node stores the number of nodes in its subtree,
+ * which lets the tree select and rank values in O(log(n)).
  */
 typedef struct bst_node_t {
   const void*        data;
@@ -62,6 +64,7 @@ typedef struct bst_node_t {
   struct bst_node_t* right;
   struct bst_node_t* parent;
   struct bst_tree_t* tree;
+  size_t             size;
 } bst_node_t;
 
 /**
@@ -74,6 +77,16 @@ typedef struct bst_tree_t {
   bst_options_t options;
 } bst_tree_t;
 
+/**
+ * @brief Describes the shape of a binary-search tree.
+ */
+typedef struct bst_stats_t {
+  /* The number of nodes in the tree. */
+  size_t size;
+  /* The number of nodes on the longest path from the root to a leaf. */
+  size_t height;
+} bst_stats_t;
+
 /**
  * @brief The result of a sort operation
  * on the nodes of a binary-search tree.
@@ -119,6 +132,17 @@ bst_node_t* bst_create_node(const void* data);
  */
 const bst_node_t* bst_insert(bst_tree_t* tree, const void* data);
 
+/**
+ * @brief Replaces the content of the binary-search tree with the given
+ * sorted values, building a tree of minimal height.
+ * @param tree a pointer to the binary-search tree.
+ * @param data an array of pointers to the data, sorted in ascending order.
+ * @param size the number of elements in the array.
+ * @return a pointer to the root of the new tree, or NULL if the array is
+ * empty, is not sorted, or if memory could not be allocated.
+ */
+const bst_node_t* bst_build_sorted(bst_tree_t* tree, const void** data, size_t size);
+
 /**
  * @brief Recursively traverse the subtree to find
  * the node associated with the given `data`.
@@ -230,6 +254,44 @@ const bst_node_t* bst_get_kth_largest(const bst_tree_t* tree, size_t k);
  */
 const bst_node_t* bst_get_kth_smallest(const bst_tree_t* tree, size_t k);
 
+/**
+ * @brief Looks up the value of the given rank in the given subtree,
+ * i.e its `k`-th smallest value starting from 0.
+ * @param node the root node associated with the subtree to look up.
+ * @param k the rank of the value to look up.
+ * @return the node associated with the value, or NULL if `k` is
+ * not less than the size of the subtree.
+ */
+const bst_node_t* bst_select_from(const bst_node_t* node, size_t k);
+
+/**
+ * @brief Looks up the value of the given rank in the binary-search tree,
+ * i.e its `k`-th smallest value starting from 0.
+ * @param tree the tree to look up the value in.
+ * @param k the rank of the value to look up.
+ * @return the node associated with the value, or NULL if `k` is
+ * not less than the size of the tree.
+ */
+const bst_node_t* bst_select(const bst_tree_t* tree, size_t k);
+
+/**
+ * @brief Computes the rank of the given `data`, which is the number
+ * of values of the binary-search tree strictly less than `data`.
+ * @param tree the tree to rank the data in.
+ * @param data the data to rank, which does not need to be in the tree.
+ * @return the number of values less than `data`.
+ */
+size_t bst_rank(const bst_tree_t* tree, const void* data);
+
+/**
+ * @brief Counts the values of the binary-search tree within the given bounds.
+ * @param tree the tree to count the values of.
+ * @param lo the inclusive lower bound.
+ * @param hi the inclusive upper bound.
+ * @return the number of values in `[lo, hi]`.
+ */
+size_t bst_count_range(const bst_tree_t* tree, const void* lo, const void* hi);
+
 /**
  * @param tree The tree to return the size of.
  * @return the number of nodes contained by the
@@ -237,6 +299,19 @@ const bst_node_t* bst_get_kth_smallest(const bst_tree_t* tree, size_t k);
  */
 size_t bst_size(const bst_tree_t* tree);
 
+/**
+ * @brief Rebalances the binary-search tree in place, restoring
+ * a minimal height using the Day-Stout-Warren algorithm.
+ * @param tree the tree to rebalance.
+ */
+void bst_rebalance(bst_tree_t* tree);
+
+/**
+ * @param tree the tree to describe.
+ * @return the size and the height of the binary-search tree.
+ */
+bst_stats_t bst_stats(const bst_tree_t* tree);
+
 /**
  * @brief Sort the nodes in the tree in ascending order.
  * @param tree the tree to sort.
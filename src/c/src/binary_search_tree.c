@@ -43,6 +43,7 @@ bst_node_t* bst_create_node(const void* data) {
 
   /* Assigning the data to the node. */
   node->data = data;
+  node->size = 1;
 
   return (node);
 }
@@ -0,0 +1,162 @@
+#include <binary_search_tree.h>
+
+/**
+ * @return the number of nodes in the given subtree.
+ */
+static size_t bst_subtree_size(const bst_node_t* node) {
+  return (node ? node->size : 0);
+}
+
+/**
+ * @brief Replaces the subtree rooted at `node` with the
+ * subtree rooted at `replacement` in the parent of `node`.
+ * @param node the node to replace.
+ * @param replacement the node to put in place of `node`.
+ */
+static void bst_transplant(bst_node_t* node, bst_node_t* replacement) {
+  if (!node->parent)
+    node->tree->root = replacement;
+  else if (node == node->parent->left)
+    node->parent->left = replacement;
+  else
+    node->parent->right = replacement;
+  replacement->parent = node->parent;
+}
+
+/**
+ * @brief Rotates the given node to the left, its right
+ * child taking its place.
+ * @param node the node to rotate.
+ * @note Complexity is O(1).
+ */
+static void bst_rotate_left(bst_node_t* node) {
+  bst_node_t* pivot = node->right;
+
+  node->right = pivot->left;
+  if (pivot->left)
+    pivot->left->parent = node;
+  bst_transplant(node, pivot);
+  pivot->left  = node;
+  node->parent = pivot;
+
+  /* The pivot now roots the subtree of the node. */
+  pivot->size = node->size;
+  node->size  = 1 + bst_subtree_size(node->left) + bst_subtree_size(node->right);
+}
+
+/**
+ * @brief Rotates the given node to the right, its left
+ * child taking its place.
+ * @param node the node to rotate.
+ * @note Complexity is O(1).
+ */
+static void bst_rotate_right(bst_node_t* node) {
+  bst_node_t* pivot = node->left;
+
+  node->left = pivot->right;
+  if (pivot->right)
+    pivot->right->parent = node;
+  bst_transplant(node, pivot);
+  pivot->right = node;
+  node->parent = pivot;
+
+  /* The pivot now roots the subtree of the node. */
+  pivot->size = node->size;
+  node->size  = 1 + bst_subtree_size(node->left) + bst_subtree_size(node->right);
+}
+
+/**
+ * @brief Performs a left rotation on every other node of the
+ * list of right children starting at the root.
+ * @param tree the tree to compress.
+ * @param count the number of rotations to perform.
+ * @note Complexity is O(count).
+ */
+static void bst_compress(bst_tree_t* tree, size_t count) {
+  bst_node_t* node = tree->root;
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    bst_rotate_left(node);
+    node = node->parent->right;
+  }
+}
+
+/**
+ * @brief Rebalances the binary-search tree in place using the
+ * Day-Stout-Warren algorithm, which first turns the tree into a
+ * sorted list of right children, then folds the list into a
+ * complete tree through left rotations.
+ * @param tree the tree to rebalance.
+ * @note Complexity is O(n) with O(1) extra space.
+ */
+void bst_rebalance(bst_tree_t* tree) {
+  bst_node_t* node;
+  size_t perfect = 1;
+
+  if (!tree) {
+    return;
+  }
+
+  /* Rotating every left child into a list of right children. */
+  for (node = tree->root; node;) {
+    if (node->left) {
+      bst_rotate_right(node);
+      node = node->parent;
+    } else {
+      node = node->right;
+    }
+  }
+
+  /* Folding the list into a perfect tree, the remaining */
+  /* nodes forming the deepest level of the tree. */
+  while (perfect * 2 + 1 <= tree->size) {
+    perfect = perfect * 2 + 1;
+  }
+  bst_compress(tree, tree->size > perfect ? tree->size - perfect : 0);
+  while (perfect > 1) {
+    perfect /= 2;
+    bst_compress(tree, perfect);
+  }
+}
+
+/**
+ * @param tree the tree to describe.
+ * @return the size and the height of the binary-search tree.
+ * @note Complexity is O(n), the tree being walked using parent
+ * links so that no stack space is consumed.
+ */
+bst_stats_t bst_stats(const bst_tree_t* tree) {
+  bst_stats_t stats = { 0, 0 };
+  const bst_node_t* node;
+  const bst_node_t* previous = NULL;
+  size_t depth = 1;
+
+  if (!tree) {
+    return (stats);
+  }
+
+  stats.size = tree->size;
+  for (node = tree->root; node;) {
+    const bst_node_t* next = NULL;
+
+    if (previous == node->parent) {
+      /* Descending into the node from its parent. */
+      if (depth > stats.height) stats.height = depth;
+      next = node->left ? node->left : node->right;
+    } else if (previous == node->left) {
+      /* Coming back from the left subtree. */
+      next = node->right;
+    }
+
+    previous = node;
+    if (next) {
+      node = next;
+      depth++;
+    } else {
+      node = node->parent;
+      depth--;
+    }
+  }
+  return (stats);
+}
@@ -26,6 +26,11 @@ static const bst_node_t* bst_attach_node(bst_node_t* node, const void* data, bst
   new_node->parent = node;
   new_node->tree = node->tree;
   new_node->tree->size++;
+
+  /* The ancestors of the new node account for it in their subtree. */
+  for (; node; node = node->parent) {
+    node->size++;
+  }
   return (new_node);
 }
 
@@ -79,3 +84,111 @@ const bst_node_t* bst_insert(bst_tree_t* tree, const void* data) {
   }
   return (bst_insert_from(tree->root, data));
 }
+
+/**
+ * @brief Describes the progress of a tree being built from sorted data.
+ */
+typedef struct bst_build_ctx_t {
+  bst_tree_t*  tree;
+  const void** data;
+  size_t       size;
+  size_t       cursor;
+  int          failed;
+} bst_build_ctx_t;
+
+/**
+ * @brief Frees the nodes of a subtree which is not yet part of a tree.
+ * @param node the root of the subtree to free.
+ */
+static void bst_free_subtree(bst_node_t* node) {
+  if (!node) return;
+  bst_free_subtree(node->left);
+  bst_free_subtree(node->right);
+  free(node);
+}
+
+/**
+ * @brief Builds a subtree of minimal height holding the next `count`
+ * distinct values of the sorted data. Nodes are allocated in order.
+ * @param ctx the build context.
+ * @param count the number of distinct values to hold in the subtree.
+ * @return the root of the subtree, or NULL if the subtree is empty
+ * or if memory could not be allocated.
+ * @note Complexity is O(n), with a recursion depth of O(log(n)).
+ */
+static bst_node_t* bst_build_from(bst_build_ctx_t* ctx, size_t count) {
+  bst_node_t* left;
+  bst_node_t* node;
+
+  if (count == 0) {
+    return (NULL);
+  }
+
+  /* Building the left subtree first, so that nodes are allocated in order. */
+  left = bst_build_from(ctx, (count - 1) / 2);
+  if (ctx->failed || (node = bst_create_node(ctx->data[ctx->cursor])) == NULL) {
+    ctx->failed = 1;
+    bst_free_subtree(left);
+    return (NULL);
+  }
+
+  /* Consuming the current value along with its duplicates. */
+  do {
+    ctx->cursor++;
+  } while (ctx->cursor < ctx->size && ctx->tree->options.comparator(ctx->data[ctx->cursor], node->data) == 0);
+
+  node->tree = ctx->tree;
+  node->size = count;
+  node->left = left;
+  if (left) left->parent = node;
+  node->right = bst_build_from(ctx, count - 1 - (count - 1) / 2);
+  if (ctx->failed) {
+    bst_free_subtree(node);
+    return (NULL);
+  }
+  if (node->right) node->right->parent = node;
+  return (node);
+}
+
+/**
+ * @brief Replaces the content of the binary-search tree with the given
+ * sorted values, building a tree of minimal height.
+ * @param tree a pointer to the binary-search tree.
+ * @param data an array of pointers to the data, sorted in ascending order.
+ * @param size the number of elements in the array.
+ * @return a pointer to the root of the new tree, or NULL if the array is
+ * empty, is not sorted, or if memory could not be allocated.
+ * @note Equal values are only inserted once, and the tree is left untouched
+ * if the array is not sorted or if memory could not be allocated.
+ * Complexity is O(n).
+ */
+const bst_node_t* bst_build_sorted(bst_tree_t* tree, const void** data, size_t size) {
+  bst_build_ctx_t ctx = { tree, data, size, 0, 0 };
+  bst_node_t* root;
+  size_t count = size > 0;
+  size_t i;
+
+  if (!tree || (size > 0 && (!data || !data[0]))) {
+    return (NULL);
+  }
+
+  /* Ensuring the data is sorted, and counting distinct values. */
+  for (i = 1; i < size; ++i) {
+    int result;
+
+    if (!data[i] || (result = tree->options.comparator(data[i], data[i - 1])) < 0) {
+      return (NULL);
+    }
+    count += result > 0;
+  }
+
+  /* Building the new nodes before clearing the tree, so that it is left untouched on failure. */
+  root = bst_build_from(&ctx, count);
+  if (ctx.failed) {
+    return (NULL);
+  }
+  bst_clear(tree);
+  tree->root = root;
+  tree->size = count;
+  return (tree->root);
+}
@@ -1,15 +1,21 @@
 #include <binary_search_tree.h>
 
 /**
- * @brief Removes the node associated with the given `data` from the binary-search tree
- * starting from the given subtree.
- * @param node the node of the subtree to walk the tree from. 
+ * @return the number of nodes in the given subtree.
+ */
+static size_t bst_subtree_size(const bst_node_t* node) {
+  return (node ? node->size : 0);
+}
+
+/**
+ * @brief Recursively removes the node associated with the given `data`
+ * from the given subtree, updating the size of the visited nodes.
+ * @param node the node of the subtree to walk the tree from.
  * @param data the data to remove from the binary-search tree.
- * @return a pointer to the successor node, or a NULL value
- * if there is no successor.
+ * @return the new root of the subtree.
  */
-bst_node_t* bst_remove_from(bst_node_t* node, const void* data) {
-  if (!node || !data)
+static bst_node_t* bst_remove_node(bst_node_t* node, const void* data) {
+  if (!node)
     return (0);
   
   /* Retrieving the tree associated with the node. */
@@ -18,9 +24,9 @@ bst_node_t* bst_remove_from(bst_node_t* node, const void* data) {
   int result = node->tree->options.comparator(data, node->data);
   
   if (result < 0)
-    node->left = bst_remove_from(node->left, data);
+    node->left = bst_remove_node(node->left, data);
   else if (result > 0)
-    node->right = bst_remove_from(node->right, data);
+    node->right = bst_remove_node(node->right, data);
   else {
     /* The node doesn't have any children. */
     if (!node->left && !node->right) {
@@ -44,12 +50,40 @@ bst_node_t* bst_remove_from(bst_node_t* node, const void* data) {
     } else {
       const bst_node_t* successor = bst_get_min_from(node->right);
       node->data = successor->data;
-      node->right = bst_remove_from(node->right, successor->data);
+      node->right = bst_remove_node(node->right, successor->data);
     }
   }
+  node->size = 1 + bst_subtree_size(node->left) + bst_subtree_size(node->right);
   return (node);
 }
 
+/**
+ * @brief Removes the node associated with the given `data` from the binary-search tree
+ * starting from the given subtree.
+ * @param node the node of the subtree to walk the tree from. 
+ * @param data the data to remove from the binary-search tree.
+ * @return a pointer to the successor node, or a NULL value
+ * if there is no successor.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+bst_node_t* bst_remove_from(bst_node_t* node, const void* data) {
+  if (!node || !data)
+    return (0);
+
+  bst_tree_t* tree     = node->tree;
+  bst_node_t* ancestor = node->parent;
+  size_t      size     = tree->size;
+  bst_node_t* result   = bst_remove_node(node, data);
+
+  /* The ancestors of the subtree lose the removed node. */
+  if (tree->size < size) {
+    for (; ancestor; ancestor = ancestor->parent) {
+      ancestor->size--;
+    }
+  }
+  return (result);
+}
+
 /**
  * @brief Removes the node associated with the given `data` from the binary-search tree.
  * @param tree a pointer to the binary-search tree.
@@ -61,16 +95,15 @@ bst_node_t* bst_remove(bst_tree_t* tree, const void* data) {
 }
 
 /**
- * @brief Clears the given binary-search subtree.
+ * @brief Recursively frees the nodes of the given subtree.
  * @param node the node associated with the subtree to clear.
- * @return the number of nodes removed from the tree.
  */
-void bst_clear_from(bst_node_t* node) {
+static void bst_clear_node(bst_node_t* node) {
   if (!node) return;
 
   /* Recursively clear the left subtree. */
-  bst_clear_from(node->left);
-  bst_clear_from(node->right);
+  bst_clear_node(node->left);
+  bst_clear_node(node->right);
 
   /* Detaching the node from its parent. */
   if (node->parent && node->parent->left == node)
@@ -88,6 +121,22 @@ void bst_clear_from(bst_node_t* node) {
   free(node);
 }
 
+/**
+ * @brief Clears the given binary-search subtree.
+ * @param node the node associated with the subtree to clear.
+ * @return the number of nodes removed from the tree.
+ */
+void bst_clear_from(bst_node_t* node) {
+  if (!node) return;
+
+  /* The ancestors of the subtree lose all of its nodes. */
+  bst_node_t* ancestor;
+  for (ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+    ancestor->size -= node->size;
+  }
+  bst_clear_node(node);
+}
+
 /**
  * @brief Clears the binary-search tree.
  * @param tree the tree to destroy.
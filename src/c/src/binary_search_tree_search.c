@@ -91,50 +91,35 @@ const bst_node_t* bst_get_max(const bst_tree_t* tree) {
   return (bst_get_max_from(tree->root));
 }
 
+/**
+ * @return the number of nodes in the given subtree.
+ */
+static size_t bst_subtree_size(const bst_node_t* node) {
+  return (node ? node->size : 0);
+}
+
 /**
  * @brief Computes the kth number associated with a given direction
- * in a subtree.
+ * in a subtree, using the size of the subtrees to skip them.
  * @param node the root node associated with the subtree to
  * look up the kth largest value in.
- * @param k a pointer to the kth number to look up.
+ * @param k the kth number to look up, starting from 1.
  * @param direction whether to look up the kth smallest or largest value.
  * @return the node associated with the kth value associated with the given direction
  * in the given subtree, or NULL if no nodes were matching.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
  */
-static const bst_node_t* bst_get_kth_number_from(const bst_node_t* node, size_t* k, bst_direction_t direction) {
-  /* Ensure that the node is valid. */
-  if (!node) {
+static const bst_node_t* bst_get_kth_number_from(const bst_node_t* node, size_t k, bst_direction_t direction) {
+  /* Ensure that the node and the rank are valid. */
+  if (!node || k == 0 || k > node->size) {
     return (NULL);
   }
 
-  /* Iterating until we reach the largest value. */
-  const bst_node_t* result = bst_get_kth_number_from(direction == BST_RIGHT ?
-    node->right : node->left,
-    k,
-    direction
-  );
-
-  /* If the kth largest value is in the right subtree,
-   * return the node associated with the kth largest value. */
-  if (result) {
-    return (result);
+  /* The kth largest value is the (size - k + 1)th smallest value. */
+  if (direction == BST_RIGHT) {
+    k = node->size - k + 1;
   }
-
-  /* Once we reached the largest value, we decrement k for each
-  number of nodes traversed backwards. */
-  (*k)--;
-
-  /* If the current node is the kth smallest, we return it. */
-  if (*k == 0) {
-    return (node);
-  }
-
-  /* Iterating over the opposite subtree to traverse all nodes. */
-  return (bst_get_kth_number_from(direction == BST_RIGHT ?
-    node->left : node->right,
-    k,
-    direction
-  ));
+  return (bst_select_from(node, k - 1));
 }
 
 /**
@@ -148,7 +133,7 @@ static const bst_node_t* bst_get_kth_number_from(const bst_node_t* node, size_t*
  * the given subtree, or NULL if no nodes were matching.
  */
 const bst_node_t* bst_get_kth_largest_from(const bst_node_t* node, size_t k) {
-  return (bst_get_kth_number_from(node, &k, BST_RIGHT));
+  return (bst_get_kth_number_from(node, k, BST_RIGHT));
 }
 
 /**
@@ -162,7 +147,7 @@ const bst_node_t* bst_get_kth_largest_from(const bst_node_t* node, size_t k) {
  * the given subtree, or NULL if no nodes were matching.
  */
 const bst_node_t* bst_get_kth_smallest_from(const bst_node_t* node, size_t k) {
-  return (bst_get_kth_number_from(node, &k, BST_LEFT));
+  return (bst_get_kth_number_from(node, k, BST_LEFT));
 }
 
 /**
@@ -188,3 +173,102 @@ const bst_node_t* bst_get_kth_largest(const bst_tree_t* tree, size_t k) {
 const bst_node_t* bst_get_kth_smallest(const bst_tree_t* tree, size_t k) {
   return (bst_get_kth_smallest_from(tree->root, k));
 }
+
+/**
+ * @brief Looks up the value of the given rank in the given subtree,
+ * i.e its `k`-th smallest value starting from 0.
+ * @param node the root node associated with the subtree to look up.
+ * @param k the rank of the value to look up.
+ * @return the node associated with the value, or NULL if `k` is
+ * not less than the size of the subtree.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+const bst_node_t* bst_select_from(const bst_node_t* node, size_t k) {
+  while (node) {
+    size_t left = bst_subtree_size(node->left);
+
+    if (k < left) {
+      node = node->left;
+    } else if (k > left) {
+      /* Skipping the left subtree and the current node. */
+      k -= left + 1;
+      node = node->right;
+    } else {
+      return (node);
+    }
+  }
+  return (NULL);
+}
+
+/**
+ * @brief Looks up the value of the given rank in the binary-search tree,
+ * i.e its `k`-th smallest value starting from 0.
+ * @param tree the tree to look up the value in.
+ * @param k the rank of the value to look up.
+ * @return the node associated with the value, or NULL if `k` is
+ * not less than the size of the tree.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+const bst_node_t* bst_select(const bst_tree_t* tree, size_t k) {
+  return (bst_select_from(tree->root, k));
+}
+
+/**
+ * @brief Counts the values of the tree less than the given `data`.
+ * @param tree the tree to count the values of.
+ * @param data the data to compare values with.
+ * @param inclusive whether values equal to `data` are counted.
+ * @return the number of matching values.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+static size_t bst_count_below(const bst_tree_t* tree, const void* data, int inclusive) {
+  const bst_node_t* node = tree->root;
+  size_t count = 0;
+
+  while (node) {
+    int result = tree->options.comparator(data, node->data);
+
+    if (result < 0 || (result == 0 && !inclusive)) {
+      node = node->left;
+    } else {
+      /* The left subtree and the current node are below `data`. */
+      count += bst_subtree_size(node->left) + 1;
+      node = node->right;
+    }
+  }
+  return (count);
+}
+
+/**
+ * @brief Computes the rank of the given `data`, which is the number
+ * of values of the binary-search tree strictly less than `data`.
+ * @param tree the tree to rank the data in.
+ * @param data the data to rank, which does not need to be in the tree.
+ * @return the number of values less than `data`.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+size_t bst_rank(const bst_tree_t* tree, const void* data) {
+  if (!tree || !data) {
+    return (0);
+  }
+  return (bst_count_below(tree, data, 0));
+}
+
+/**
+ * @brief Counts the values of the binary-search tree within the given bounds.
+ * @param tree the tree to count the values of.
+ * @param lo the inclusive lower bound.
+ * @param hi the inclusive upper bound.
+ * @return the number of values in `[lo, hi]`.
+ * @note Complexity is O(log(n)) on average, O(n) on the worst case.
+ */
+size_t bst_count_range(const bst_tree_t* tree, const void* lo, const void* hi) {
+  size_t upper, lower;
+
+  if (!tree || !lo || !hi) {
+    return (0);
+  }
+  upper = bst_count_below(tree, hi, 1);
+  lower = bst_count_below(tree, lo, 0);
+  return (upper > lower ? upper - lower : 0);
+}
@@ -0,0 +1,76 @@
+#include <binary_search_tree.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <math.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
+
+/**
+ * @return whether parent links and subtree sizes are
+ * consistent in the given subtree.
+ */
+static bool is_consistent(const bst_node_t* node) {
+  if (!node) {
+    return (true);
+  }
+  if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node)) {
+    return (false);
+  }
+  if (node->size != 1 + (node->left ? node->left->size : 0) + (node->right ? node->right->size : 0)) {
+    return (false);
+  }
+  return (is_consistent(node->left) && is_consistent(node->right));
+}
+
+TEST(BALANCE, OF_DEGENERATE_TREE) {
+  static int values[1000];
+
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+
+  // Inserting sorted values degrades the tree into a list.
+  for (size_t i = 0; i < ARRAY_SIZE(values); ++i) {
+    values[i] = (int) i;
+    bst_insert(tree, &values[i]);
+  }
+  EXPECT_EQ(bst_stats(tree).height, ARRAY_SIZE(values));
+
+  // Rebalancing the tree restores a minimal height.
+  bst_rebalance(tree);
+  EXPECT_EQ(bst_stats(tree).size, ARRAY_SIZE(values));
+  EXPECT_EQ(bst_stats(tree).height, (size_t) 10);
+  EXPECT_EQ(tree->root->parent, nullptr);
+  EXPECT_TRUE(is_consistent(tree->root));
+
+  // Every value is reachable and ordered.
+  for (size_t i = 0; i < ARRAY_SIZE(values); ++i) {
+    EXPECT_EQ(bst_find(tree, &values[i])->data, &values[i]);
+    EXPECT_EQ(bst_select(tree, i)->data, &values[i]);
+  }
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}
+
+TEST(BALANCE, OF_SMALL_TREES) {
+  static const int values[] = { 4, 2, 6, 1, 3, 5, 7 };
+
+  for (size_t size = 0; size <= ARRAY_SIZE(values); ++size) {
+    // Creating a new binary search tree.
+    bst_tree_t* tree = bst_create((bst_options_t) {
+      .comparator = &bst_integer_comparator
+    });
+
+    for (size_t i = 0; i < size; ++i) {
+      bst_insert(tree, &values[i]);
+    }
+    bst_rebalance(tree);
+    EXPECT_EQ(bst_stats(tree).height, (size_t) ceil(log2(size + 1)));
+    EXPECT_TRUE(is_consistent(tree->root));
+
+    // Destroying the tree.
+    bst_destroy(tree);
+  }
+}
@@ -0,0 +1,92 @@
+#include <binary_search_tree.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
+
+/**
+ * @return the height of the given subtree, checking that parent
+ * links and subtree sizes are consistent.
+ */
+static size_t checked_height_of(const bst_node_t* node) {
+  if (!node) {
+    return (0);
+  }
+  if (node->left) {
+    EXPECT_EQ(node->left->parent, node);
+  }
+  if (node->right) {
+    EXPECT_EQ(node->right->parent, node);
+  }
+  EXPECT_EQ(node->size, 1 + (node->left ? node->left->size : 0) + (node->right ? node->right->size : 0));
+
+  size_t left  = checked_height_of(node->left);
+  size_t right = checked_height_of(node->right);
+  return (1 + (left > right ? left : right));
+}
+
+TEST(BUILD, FROM_SORTED_DATA) {
+  static int values[1000];
+  const void* data[ARRAY_SIZE(values)];
+
+  for (size_t i = 0; i < ARRAY_SIZE(values); ++i) {
+    values[i] = (int) i;
+    data[i] = &values[i];
+  }
+
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+  bst_insert(tree, &values[10]);
+
+  // Building the tree replaces its content.
+  EXPECT_NE(bst_build_sorted(tree, data, ARRAY_SIZE(data)), nullptr);
+  EXPECT_EQ(bst_size(tree), ARRAY_SIZE(values));
+  EXPECT_EQ(checked_height_of(tree->root), (size_t) 10);
+  EXPECT_EQ(tree->root->parent, nullptr);
+
+  // Every value is reachable and ordered.
+  for (size_t i = 0; i < ARRAY_SIZE(values); ++i) {
+    EXPECT_EQ(bst_find(tree, &values[i])->data, &values[i]);
+    EXPECT_EQ(bst_select(tree, i)->data, &values[i]);
+  }
+
+  // The tree can be modified once built.
+  bst_remove(tree, &values[500]);
+  EXPECT_EQ(bst_rank(tree, &values[501]), (size_t) 500);
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}
+
+TEST(BUILD, FROM_INVALID_DATA) {
+  const int values[] = { 1, 1, 2, 3, 3, 0 };
+  const void* data[ARRAY_SIZE(values)];
+
+  for (size_t i = 0; i < ARRAY_SIZE(values); ++i) {
+    data[i] = &values[i];
+  }
+
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+
+  // Equal values are only inserted once.
+  EXPECT_NE(bst_build_sorted(tree, data, 5), nullptr);
+  EXPECT_EQ(bst_size(tree), (size_t) 3);
+  EXPECT_EQ(checked_height_of(tree->root), (size_t) 2);
+
+  // Unsorted data is rejected, leaving the tree untouched.
+  EXPECT_EQ(bst_build_sorted(tree, data, ARRAY_SIZE(data)), nullptr);
+  EXPECT_EQ(bst_size(tree), (size_t) 3);
+
+  // Empty data clears the tree.
+  EXPECT_EQ(bst_build_sorted(tree, data, 0), nullptr);
+  EXPECT_EQ(bst_size(tree), (size_t) 0);
+  EXPECT_EQ(tree->root, nullptr);
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}
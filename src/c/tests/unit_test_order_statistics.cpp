@@ -0,0 +1,111 @@
+#include <binary_search_tree.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
+
+  /** The tree must be layed-out acccording to the following structure. */
+  /**                        50                                          */
+  /**                       /  \                                         */
+  /**                     20     70                                      */
+  /**                    /  \   /  \                                     */
+  /**                  10   40 60  90                                    */
+  /**                               \                                    */
+  /**                                100                                 */
+static const int data[] = { 50, 70, 60, 20, 90, 10, 40, 100 };
+
+/**
+ * @return the size of the given subtree, checking that every node
+ * stores the number of nodes of its subtree.
+ */
+static size_t checked_size_of(const bst_node_t* node) {
+  if (!node) {
+    return (0);
+  }
+  size_t size = 1 + checked_size_of(node->left) + checked_size_of(node->right);
+  EXPECT_EQ(node->size, size);
+  return (size);
+}
+
+TEST(ORDER_STATISTICS, SELECT_AND_RANK) {
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+
+  // Inserting the data.
+  for (size_t i = 0; i < ARRAY_SIZE(data); ++i) {
+    bst_insert(tree, &data[i]);
+  }
+  EXPECT_EQ(checked_size_of(tree->root), ARRAY_SIZE(data));
+
+  EXPECT_EQ(*(int*) bst_select(tree, 0)->data, 10);
+  EXPECT_EQ(*(int*) bst_select(tree, 3)->data, 50);
+  EXPECT_EQ(*(int*) bst_select(tree, 7)->data, 100);
+  EXPECT_EQ(bst_select(tree, 8), nullptr);
+
+  // Values absent from the tree can be ranked.
+  const int values[] = { 10, 55, 1000 };
+  EXPECT_EQ(bst_rank(tree, &values[0]), (size_t) 0);
+  EXPECT_EQ(bst_rank(tree, &values[1]), (size_t) 4);
+  EXPECT_EQ(bst_rank(tree, &values[2]), (size_t) 8);
+
+  // The kth smallest and largest values are 1-based.
+  EXPECT_EQ(*(int*) bst_get_kth_smallest(tree, 1)->data, 10);
+  EXPECT_EQ(*(int*) bst_get_kth_largest(tree, 2)->data, 90);
+  EXPECT_EQ(bst_get_kth_largest(tree, 9), nullptr);
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}
+
+TEST(ORDER_STATISTICS, COUNT_RANGE) {
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+
+  // Inserting the data.
+  for (size_t i = 0; i < ARRAY_SIZE(data); ++i) {
+    bst_insert(tree, &data[i]);
+  }
+
+  const int bounds[] = { 20, 60, 21, 59 };
+  EXPECT_EQ(bst_count_range(tree, &bounds[0], &bounds[1]), (size_t) 4);
+  EXPECT_EQ(bst_count_range(tree, &bounds[2], &bounds[3]), (size_t) 2);
+  EXPECT_EQ(bst_count_range(tree, &bounds[1], &bounds[0]), (size_t) 0);
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}
+
+TEST(ORDER_STATISTICS, AFTER_REMOVAL) {
+  // Creating a new binary search tree.
+  bst_tree_t* tree = bst_create((bst_options_t) {
+    .comparator = &bst_integer_comparator
+  });
+
+  // Inserting the data.
+  for (size_t i = 0; i < ARRAY_SIZE(data); ++i) {
+    bst_insert(tree, &data[i]);
+  }
+
+  // Removing nodes with two, one and no children.
+  bst_remove(tree, &data[0]);
+  bst_remove(tree, &data[4]);
+  bst_remove(tree, &data[5]);
+  EXPECT_EQ(checked_size_of(tree->root), (size_t) 5);
+  EXPECT_EQ(*(int*) bst_select(tree, 0)->data, 20);
+  EXPECT_EQ(*(int*) bst_select(tree, 4)->data, 100);
+
+  // Removing from a subtree updates its ancestors.
+  bst_remove_from(tree->root->left, &data[6]);
+  EXPECT_EQ(checked_size_of(tree->root), (size_t) 4);
+
+  // Clearing a subtree updates its ancestors.
+  bst_clear_from(tree->root->right);
+  EXPECT_EQ(checked_size_of(tree->root), bst_size(tree));
+
+  // Destroying the tree.
+  bst_destroy(tree);
+}